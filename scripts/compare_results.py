@@ -0,0 +1,223 @@
+#!/usr/bin/env python
+
+import argparse
+import json
+import math
+import os
+import re
+import shutil
+import sys
+
+from collections import defaultdict
+
+# Exit codes, to be able to use this script for gating library upgrades.
+exit_success = 0
+exit_regression = 1
+exit_error = 2
+
+# Default directory that stores named baselines.
+default_baseline_dir = 'baselines'
+
+def load_samples(filename, metric):
+    """Returns a mapping from a benchmark name to the list of measurements of the
+    given metric over all repetitions of that benchmark, skipping aggregates and
+    benchmarks that reported an error."""
+    with open(filename, 'r') as json_file:
+        benchmarks = json.load(json_file)['benchmarks']
+
+    samples = defaultdict(list)
+    for benchmark in benchmarks:
+        if benchmark.get('run_type', 'iteration') != 'iteration' or 'error_occurred' in benchmark:
+            continue
+        samples[benchmark.get('run_name', benchmark['name'])].append(float(benchmark[metric]))
+    return samples
+
+def ranks(values):
+    """Returns the ranks of the given values, assigning the average rank to ties,
+    and the sum of t^3 - t over all groups of t tied values."""
+    order = sorted(range(len(values)), key=lambda i: values[i])
+    result = [0.0] * len(values)
+    tie_sum = 0
+    i = 0
+    while i < len(order):
+        j = i
+        while j + 1 < len(order) and values[order[j + 1]] == values[order[i]]:
+            j += 1
+        for k in range(i, j + 1):
+            result[order[k]] = (i + j) / 2.0 + 1
+        t = j - i + 1
+        tie_sum += t ** 3 - t
+        i = j + 1
+    return result, tie_sum
+
+def exact_u_distribution(n1, n2):
+    """Returns the number of arrangements of two samples of the given sizes for
+    every value of the Mann-Whitney U statistic."""
+    # counts[j][u] is the number of arrangements of i and j values with statistic u.
+    counts = [[1] + [0] * (n1 * n2) for _ in range(n2 + 1)]
+    for i in range(1, n1 + 1):
+        next_counts = [[0] * (n1 * n2 + 1) for _ in range(n2 + 1)]
+        next_counts[0][0] = 1
+        for j in range(1, n2 + 1):
+            for u in range(i * j + 1):
+                next_counts[j][u] = (counts[j][u - j] if u >= j else 0) + next_counts[j - 1][u]
+        counts = next_counts
+    return counts[n2]
+
+def mann_whitney_u(x, y):
+    """Two-sided Mann-Whitney U test; returns the U statistic for x and the
+    p-value. The exact distribution is used for small samples without ties,
+    otherwise the normal approximation with tie correction is used."""
+    n1, n2 = len(x), len(y)
+    r, tie_sum = ranks(x + y)
+    u1 = sum(r[:n1]) - n1 * (n1 + 1) / 2.0
+    u = min(u1, n1 * n2 - u1)
+
+    if tie_sum == 0 and n1 * n2 <= 400:
+        distribution = exact_u_distribution(n1, n2)
+        p = 2.0 * sum(distribution[:int(u) + 1]) / sum(distribution)
+        return u1, min(1.0, p)
+
+    n = n1 + n2
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_sum / float(n * (n - 1)))
+    if variance <= 0:
+        return u1, 1.0
+
+    # Continuity correction.
+    z = (abs(u1 - mean) - 0.5) / math.sqrt(variance)
+    return u1, min(1.0, math.erfc(max(0.0, z) / math.sqrt(2)))
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    return values[mid] if len(values) % 2 else (values[mid - 1] + values[mid]) / 2.0
+
+def compare(baseline, contender, alpha, threshold, min_samples):
+    """Compares the samples of all benchmarks that are part of both runs; returns
+    a list of tuples of the benchmark name, baseline median, contender median,
+    relative change, p-value, and verdict."""
+    results = []
+    for name in sorted(set(baseline) & set(contender)):
+        x, y = baseline[name], contender[name]
+        x_median, y_median = median(x), median(y)
+        change = y_median / x_median - 1 if x_median > 0 else float('NaN')
+
+        if min(len(x), len(y)) < min_samples:
+            results.append((name, x_median, y_median, change, float('NaN'), 'insufficient samples'))
+            continue
+
+        _, p = mann_whitney_u(x, y)
+        verdict = 'unchanged'
+        if p < alpha and change > threshold:
+            verdict = 'REGRESSION'
+        elif p < alpha and change < -threshold:
+            verdict = 'improvement'
+        results.append((name, x_median, y_median, change, p, verdict))
+    return results
+
+def resolve_run(run, baseline_dir):
+    """Returns the filename of the given run, which is either a JSON file, or the
+    name of a stored baseline."""
+    if os.path.isfile(run):
+        return run
+    stored = os.path.join(baseline_dir, run + '.json')
+    if os.path.isfile(stored):
+        return stored
+    raise FileNotFoundError("'%s' is neither a JSON file nor a stored baseline in '%s'" % (run, baseline_dir))
+
+def store_baseline(args):
+    os.makedirs(args.baseline_dir, exist_ok=True)
+    destination = os.path.join(args.baseline_dir, args.name + '.json')
+    shutil.copyfile(args.input, destination)
+    print("Stored '%s' as baseline '%s' in '%s'." % (args.input, args.name, destination))
+    return exit_success
+
+def list_baselines(args):
+    if os.path.isdir(args.baseline_dir):
+        for filename in sorted(os.listdir(args.baseline_dir)):
+            if filename.endswith('.json'):
+                print(filename[:-len('.json')])
+    return exit_success
+
+def compare_runs(args):
+    baseline = load_samples(resolve_run(args.baseline, args.baseline_dir), args.metric)
+    contender = load_samples(resolve_run(args.contender, args.baseline_dir), args.metric)
+
+    if args.filter:
+        regex = re.compile(args.filter)
+        baseline = {name: samples for name, samples in baseline.items() if regex.search(name)}
+        contender = {name: samples for name, samples in contender.items() if regex.search(name)}
+
+    results = compare(baseline, contender, args.alpha, args.threshold, args.min_samples)
+    if not results:
+        print('No benchmarks in common between the baseline and contender runs.', file=sys.stderr)
+        return exit_error
+
+    name_width = max(len(name) for name, *_ in results)
+    print('%-*s %14s %14s %9s %9s  %s' % (name_width, 'Benchmark', 'Baseline', 'Contender', 'Change', 'p-value', 'Verdict'))
+    for name, x_median, y_median, change, p, verdict in results:
+        if args.only_changes and verdict in ('unchanged', 'insufficient samples'):
+            continue
+        print('%-*s %14.4f %14.4f %+8.1f%% %9.4f  %s' % (name_width, name, x_median, y_median, 100 * change, p, verdict))
+
+    missing = sorted(set(baseline) - set(contender))
+    added = sorted(set(contender) - set(baseline))
+    for name in missing:
+        print('%s: missing in contender run' % name, file=sys.stderr)
+    for name in added:
+        print('%s: not part of baseline run' % name, file=sys.stderr)
+
+    num_regressions = sum(1 for *_, verdict in results if verdict == 'REGRESSION')
+    num_improvements = sum(1 for *_, verdict in results if verdict == 'improvement')
+    num_insufficient = sum(1 for *_, verdict in results if verdict == 'insufficient samples')
+    print('\n%d benchmarks compared on %s: %d regressions, %d improvements (p < %g, change > %g%%).'
+          % (len(results), args.metric, num_regressions, num_improvements, args.alpha, 100 * args.threshold))
+    if num_insufficient:
+        print('%d benchmarks have fewer than %d repetitions, run PLYbench using --benchmark_repetitions=N.'
+              % (num_insufficient, args.min_samples), file=sys.stderr)
+
+    return exit_regression if num_regressions > 0 else exit_success
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+            prog='compare_results.py',
+            description='Stores PLYbench results as named baselines, and compares two PLYbench runs using a '
+                        'Mann-Whitney U test per benchmark. Exits with %d in case no regressions were found, '
+                        '%d in case of a regression, and %d in case of an error.' % (exit_success, exit_regression, exit_error))
+    parser.add_argument('--baseline-dir', default=default_baseline_dir,
+                        help='directory that stores named baselines, default: %s' % default_baseline_dir)
+
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    store_parser = subparsers.add_parser('store', help='store a JSON file generated by PLYbench as a named baseline')
+    store_parser.add_argument('-i', '--input', required=True, help='input JSON file generated by PLYbench')
+    store_parser.add_argument('-n', '--name', required=True, help='name of the baseline, for example a library version')
+    store_parser.set_defaults(fn=store_baseline)
+
+    list_parser = subparsers.add_parser('list', help='list all stored baselines')
+    list_parser.set_defaults(fn=list_baselines)
+
+    compare_parser = subparsers.add_parser('compare', help='compare a contender run against a baseline run')
+    compare_parser.add_argument('baseline', help='JSON file generated by PLYbench, or the name of a stored baseline')
+    compare_parser.add_argument('contender', help='JSON file generated by PLYbench, or the name of a stored baseline')
+    compare_parser.add_argument('-m', '--metric', default='cpu_time', choices=['cpu_time', 'real_time'],
+                                help='metric to compare, default: cpu_time')
+    compare_parser.add_argument('-a', '--alpha', type=float, default=0.05,
+                                help='significance level of the Mann-Whitney U test, default: 0.05')
+    compare_parser.add_argument('-t', '--threshold', type=float, default=0.05,
+                                help='minimum relative change in the median to report, default: 0.05 (5%%)')
+    compare_parser.add_argument('--min-samples', type=int, default=3,
+                                help='minimum number of repetitions per benchmark in both runs, default: 3')
+    compare_parser.add_argument('-f', '--filter', help='only compare benchmarks matching the given regular expression')
+    compare_parser.add_argument('--only-changes', action='store_true',
+                                help='only list benchmarks that regressed or improved')
+    compare_parser.set_defaults(fn=compare_runs)
+
+    args = parser.parse_args()
+
+    try:
+        sys.exit(args.fn(args))
+    except (OSError, ValueError, KeyError) as e:
+        print('Error: %s' % e, file=sys.stderr)
+        sys.exit(exit_error)
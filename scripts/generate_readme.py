@@ -2,6 +2,7 @@
 
 import argparse
 import json
+import re
 import string
 import sys
 
@@ -40,6 +41,30 @@ write_benchmark_library_names = { \
     'BM_WriteTinyply' : 'tinyply 2.3' \
 }
 
+# Matches the name of a model from the synthetic corpus size sweep, for example
+# 'Scanned surface 10K (ASCII)'.
+sweep_model_regex = re.compile(r'^(.*) (\d+[KM]?) \((.*)\)$')
+
+# Mesh size of the write benchmarks that is used for the results table.
+reference_write_triangles = 100000
+
+def reference_benchmarks(benchmarks):
+    """Selects the benchmarks for the results tables; parse benchmarks for all
+    models that are not part of the size sweep without any benchmark variants
+    like cold page cache, and write benchmarks to disk for the reference mesh
+    size."""
+    result = []
+    for benchmark in benchmarks:
+        benchmark_name, _, model_name = benchmark['name'].partition('/')
+        if benchmark_name in parse_benchmark_library_names:
+            if '/' not in model_name and not sweep_model_regex.match(model_name.strip('"')):
+                result.append(benchmark)
+        elif benchmark_name in write_benchmark_library_names:
+            format_name, _, triangles = model_name.partition('/triangles:')
+            if '/' not in format_name and triangles == str(reference_write_triangles):
+                result.append(dict(benchmark, name='%s/%s' % (benchmark_name, format_name)))
+    return result
+
 def make_results_table(benchmarks, benchmark_library_names, format_type_fn):
     # Mapping from a library name and model name to the time required to parse
     # that model by that library.
@@ -143,7 +168,7 @@ if __name__ == '__main__':
 
     benchmarks = None
     with open(args.input, 'r') if args.input is not None else sys.stdin as json_file:
-        benchmarks = json.load(json_file)['benchmarks']
+        benchmarks = reference_benchmarks(json.load(json_file)['benchmarks'])
 
     if not benchmarks:
         print('Problem loading benchmark data, invalid JSON?')
@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+
+import argparse
+import json
+import math
+import re
+import sys
+
+from collections import defaultdict
+
+# Matches the malloc configuration component of a benchmark name.
+malloc_config_regex = re.compile(r'/malloc:([^/]*)')
+
+def load_times(filename, metric):
+    """Returns a mapping from a benchmark name to the mean of the given metric over
+    all repetitions of that benchmark, skipping aggregates and benchmarks that
+    reported an error."""
+    with open(filename, 'r') as json_file:
+        benchmarks = json.load(json_file)['benchmarks']
+
+    samples = defaultdict(list)
+    for benchmark in benchmarks:
+        if benchmark.get('run_type', 'iteration') != 'iteration' or 'error_occurred' in benchmark:
+            continue
+        samples[benchmark.get('run_name', benchmark['name'])].append(float(benchmark[metric]))
+    return {name: sum(values) / len(values) for name, values in samples.items()}
+
+def split_name(name):
+    """Splits a benchmark name into the name of the benchmark for the default
+    malloc configuration, and the name of the malloc configuration."""
+    match = malloc_config_regex.search(name)
+    if not match:
+        return name, 'default'
+    return name[:match.start()] + name[match.end():], match.group(1)
+
+def geometric_mean(values):
+    return math.exp(sum(math.log(value) for value in values) / len(values))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+            prog='malloc_sensitivity.py',
+            description='Reports how sensitive the parse and write benchmarks of every PLY library are to the '
+                        'malloc configurations given to PLYbench using --plybench_malloc_configs, as the time '
+                        'relative to the default configuration.')
+    parser.add_argument('-i', '--input', required=True, help='input JSON file generated by PLYbench')
+    parser.add_argument('-m', '--metric', default='cpu_time', choices=['cpu_time', 'real_time'],
+                        help='metric to compare, default: cpu_time')
+    parser.add_argument('-v', '--verbose', action='store_true', help='list the relative time of every benchmark')
+    args = parser.parse_args()
+
+    try:
+        times = load_times(args.input, args.metric)
+    except (OSError, ValueError, KeyError) as e:
+        print('Error: %s' % e, file=sys.stderr)
+        sys.exit(1)
+
+    # Relative time per malloc configuration for every benchmark, and per
+    # library, where a library is identified by the benchmark function name, like
+    # BM_ParseRPly.
+    relative = defaultdict(dict)
+    for name, time in times.items():
+        default_name, config = split_name(name)
+        if config != 'default' and times.get(default_name, 0) > 0 and time > 0:
+            relative[default_name][config] = time / times[default_name]
+
+    if not relative:
+        print('No benchmarks with a non-default malloc configuration found.', file=sys.stderr)
+        sys.exit(1)
+
+    configs = sorted({config for ratios in relative.values() for config in ratios})
+    widths = [max(12, len(config)) for config in configs]
+
+    def format_row(ratios):
+        return '  '.join('%+*.1f%%' % (width - 1, 100 * (ratios[config] - 1)) if config in ratios else '%*s' % (width, '-')
+                         for config, width in zip(configs, widths))
+
+    header = '  '.join('%*s' % (width, config) for config, width in zip(configs, widths))
+
+    if args.verbose:
+        name_width = max(len(name) for name in relative)
+        print('%-*s  %s' % (name_width, 'Benchmark', header))
+        for name in sorted(relative):
+            print('%-*s  %s' % (name_width, name, format_row(relative[name])))
+        print()
+
+    per_library = defaultdict(lambda: defaultdict(list))
+    for name, ratios in relative.items():
+        for config, ratio in ratios.items():
+            per_library[name.split('/')[0]][config].append(ratio)
+
+    # The sensitivity of a library is the largest absolute change in the geometric
+    # mean of the relative time over all configurations.
+    library_width = max(len('Library'), max(len(library) for library in per_library))
+    print('%-*s  %s  %12s' % (library_width, 'Library', header, 'Sensitivity'))
+    for library in sorted(per_library):
+        means = {config: geometric_mean(ratios) for config, ratios in per_library[library].items()}
+        sensitivity = max(abs(mean - 1) for mean in means.values())
+        print('%-*s  %s  %11.1f%%' % (library_width, library, format_row(means), 100 * sensitivity))
@@ -8,6 +8,8 @@ import os
 import re
 import sys
 
+from collections import defaultdict
+
 dpi = 163
 width = 3840
 height = 2160
@@ -43,6 +45,48 @@ write_benchmark_parser_names = { \
     'BM_WriteTinyply' : 'tinyply 2.3' \
 }
 
+# Matches the name of a model from the synthetic corpus size sweep, for example
+# 'Scanned surface 10K (ASCII)'.
+sweep_model_regex = re.compile(r'^(.*) (\d+[KM]?) \((.*)\)$')
+
+# Mesh size of the write benchmarks that is used for the bar graphs.
+reference_write_triangles = 100000
+
+def parse_triangle_count(text):
+    multipliers = {'K': 1000, 'M': 1000000}
+    return int(text[:-1]) * multipliers[text[-1]] if text[-1] in multipliers else int(text)
+
+def reference_benchmarks(benchmarks):
+    """Selects the benchmarks for the bar graphs; parse benchmarks for all
+    models that are not part of the size sweep without any benchmark variants
+    like cold page cache, and write benchmarks to disk for the reference mesh
+    size."""
+    result = []
+    for benchmark in benchmarks:
+        benchmark_name, _, model_name = benchmark['name'].partition('/')
+        if benchmark_name in parse_benchmark_parser_names:
+            if '/' not in model_name and not sweep_model_regex.match(model_name.strip('"')):
+                result.append(benchmark)
+        elif benchmark_name in write_benchmark_parser_names:
+            format_name, _, triangles = model_name.partition('/triangles:')
+            if '/' not in format_name and triangles == str(reference_write_triangles):
+                result.append(dict(benchmark, name='%s/%s' % (benchmark_name, format_name)))
+    return result
+
+def cold_cache_benchmarks(benchmarks, variant):
+    """Selects the parse benchmarks of the given cold cache variant, for example
+    'cold page cache', reading from file for models that are not part of the
+    size sweep, stripping the variant from the benchmark name."""
+    result = []
+    for benchmark in benchmarks:
+        name = re.sub('/real_time$', '', benchmark['name'])
+        if name.endswith('/' + variant):
+            name = name[:-len('/' + variant)]
+            benchmark_name, _, model_name = name.partition('/')
+            if benchmark_name in parse_benchmark_parser_names and '/' not in model_name and not sweep_model_regex.match(model_name.strip('"')):
+                result.append(dict(benchmark, name=name))
+    return result
+
 def legend_without_duplicate_labels(ax, **kwargs):
     handles, labels = ax.get_legend_handles_labels()
     unique = [(h, l) for i, (h, l) in enumerate(zip(handles, labels)) if l not in labels[:i]]
@@ -133,6 +177,65 @@ def render_graph(benchmarks, output_png_file, benchmark_metric, benchmark_parser
 
     matplotlib.pyplot.savefig(output_png_file, format='png', dpi=dpi)
 
+def render_scaling_graph(benchmarks, output_png_file, benchmark_parser_names, title):
+    # Mapping from a format name to a mapping from a parser name to a list of
+    # tuples of the number of triangles and the associated transfer speed.
+    metrics_by_format = defaultdict(lambda: defaultdict(list))
+
+    for benchmark in filter(lambda bm : 'error_occurred' not in bm, benchmarks):
+        benchmark_name, _, model_name = benchmark['name'].partition('/')
+        if benchmark_name not in benchmark_parser_names:
+            continue
+
+        m = sweep_model_regex.match(model_name.strip('"'))
+        if m:
+            format_name, triangles = m.group(3), parse_triangle_count(m.group(2))
+        else:
+            format_name, _, triangles = model_name.partition('/triangles:')
+            if not triangles or '/' in format_name:
+                continue
+            triangles = int(triangles)
+
+        parser_name = benchmark_parser_names[benchmark_name]
+        metrics_by_format[format_name][parser_name].append((triangles, benchmark['bytes_per_second'] / (1024 * 1024)))
+
+    fig, axes = matplotlib.pyplot.subplots(1, max(1, len(metrics_by_format)), figsize=(width / dpi, height / dpi), squeeze=False)
+
+    prop_cycle = matplotlib.pyplot.rcParams['axes.prop_cycle']
+    colors = prop_cycle.by_key()['color']
+    parser_color = {parser_name: colors[idx] for idx, parser_name in enumerate(benchmark_parser_names.values())}
+
+    for ax, (format_name, metrics_by_parser) in zip(axes[0], sorted(metrics_by_format.items())):
+        for parser_name, metrics in sorted(metrics_by_parser.items()):
+            metrics.sort()
+            ax.plot([t for t, _ in metrics], [m for _, m in metrics], marker='o', label=parser_name, color=parser_color[parser_name])
+
+        ax.set_xscale('log')
+        ax.set_title(format_name, fontsize=legend_fontsize)
+        ax.set_xlabel('#Triangles', fontsize=legend_fontsize)
+        ax.set_ylabel('Transfer speed [MiB/s]', fontsize=legend_fontsize)
+        ax.tick_params(axis='both', labelsize=ticks_fontsize * 0.75)
+        ax.legend(fontsize=legend_fontsize * 0.75)
+
+    fig.suptitle(title, fontsize=title_fontsize)
+    fig.tight_layout()
+
+    matplotlib.pyplot.savefig(output_png_file, format='png', dpi=dpi)
+
+def render_parse_scaling_graph(benchmarks, output_png_file):
+    render_scaling_graph(benchmarks,
+                         output_png_file,
+                         parse_benchmark_parser_names,
+                         'Data transfer speeds parsing generated models per mesh size [MiB/s] (higher is better)'
+    )
+
+def render_write_scaling_graph(benchmarks, output_png_file):
+    render_scaling_graph(benchmarks,
+                         output_png_file,
+                         write_benchmark_parser_names,
+                         'Data transfer speeds writing triangle meshes per mesh size [MiB/s] (higher is better)'
+    )
+
 def render_parse_cpu_time_graph(benchmarks, output_png_file):
     time_unit = None if not benchmarks else benchmarks[0]['time_unit']
     render_graph(benchmarks,
@@ -166,6 +269,19 @@ def render_parse_transfer_speed_graph(benchmarks, output_png_file):
                  metrics_reversed=True
     )
 
+def render_parse_cold_cache_graph(benchmarks, output_png_file, variant):
+    for benchmark in benchmarks:
+        benchmark['mib_per_second'] = float('NaN') if 'error_occurred' in benchmark else benchmark['bytes_per_second'] / (1024 * 1024)
+
+    render_graph(benchmarks,
+                 output_png_file,
+                 'mib_per_second',
+                 parse_benchmark_parser_names,
+                 'Data transfer speeds parsing various models with a %s [MiB/s] (higher is better)' % variant,
+                 'Read performance [MiB/s]',
+                 metrics_reversed=True
+    )
+
 def render_write_transfer_speed_graph(benchmarks, output_png_file):
     for benchmark in benchmarks:
         benchmark['mib_per_second'] = float('NaN') if 'error_occurred' in benchmark else benchmark['bytes_per_second'] / (1024 * 1024)
@@ -184,7 +300,7 @@ if __name__ == '__main__':
             prog='plot_graph.py',
             description='Plots various graphs given the JSON output generated by PLYbench.')
 
-    graph_type_choices = ['parse_cpu_time', 'write_cpu_time', 'parse_transfer_speed', 'write_transfer_speed']
+    graph_type_choices = ['parse_cpu_time', 'write_cpu_time', 'parse_transfer_speed', 'write_transfer_speed', 'parse_scaling', 'write_scaling', 'parse_cold_page_cache', 'parse_cold_cpu_cache']
 
     parser.add_argument('-i', '--input',
                         help='input JSON file generated by PLYbench, in case this is not specified, stdin is used instead')
@@ -207,10 +323,18 @@ if __name__ == '__main__':
 
     with open(args.output, 'wb') if args.output is not None else sys.stdout as png_file:
         if args.type == 'parse_cpu_time':
-            render_parse_cpu_time_graph(benchmarks, png_file)
+            render_parse_cpu_time_graph(reference_benchmarks(benchmarks), png_file)
         elif args.type == 'write_cpu_time':
-            render_write_cpu_time_graph(benchmarks, png_file)
+            render_write_cpu_time_graph(reference_benchmarks(benchmarks), png_file)
         elif args.type == 'parse_transfer_speed':
-            render_parse_transfer_speed_graph(benchmarks, png_file)
+            render_parse_transfer_speed_graph(reference_benchmarks(benchmarks), png_file)
         elif args.type == 'write_transfer_speed':
-            render_write_transfer_speed_graph(benchmarks, png_file)
+            render_write_transfer_speed_graph(reference_benchmarks(benchmarks), png_file)
+        elif args.type == 'parse_scaling':
+            render_parse_scaling_graph(benchmarks, png_file)
+        elif args.type == 'write_scaling':
+            render_write_scaling_graph(benchmarks, png_file)
+        elif args.type == 'parse_cold_page_cache':
+            render_parse_cold_cache_graph(cold_cache_benchmarks(benchmarks, 'cold page cache'), png_file, 'cold page cache')
+        elif args.type == 'parse_cold_cpu_cache':
+            render_parse_cold_cache_graph(cold_cache_benchmarks(benchmarks, 'cold CPU cache'), png_file, 'cold CPU cache')
@@ -0,0 +1,142 @@
+#include "backends.h"
+
+#include "parsers.h"
+#include "writers.h"
+
+#include <algorithm>
+
+namespace {
+const std::vector<Format> allFormats{Format::Ascii, Format::BinaryLittleEndian, Format::BinaryBigEndian};
+
+// Note; tinyply 2.3 seems to be broken for ASCII
+// (https://github.com/ddiakopoulos/tinyply/issues/59)
+const std::vector<Format> binaryFormats{Format::BinaryLittleEndian, Format::BinaryBigEndian};
+
+// Formats the write benchmarks are run for.
+const std::vector<Format> writeFormats{Format::Ascii, Format::BinaryLittleEndian};
+
+template<typename T>
+bool contains(const std::vector<T> &values, const T &value)
+{
+  return std::find(values.begin(), values.end(), value) != values.end();
+}
+}
+
+bool ParserBackend::supports(InputSource inputSource) const
+{
+  return inputSource == InputSource::File || parseInput;
+}
+
+bool ParserBackend::supports(Format format) const
+{
+  return contains(formats, format);
+}
+
+bool ParserBackend::supports(MeshPrecision precision) const
+{
+  return visitMeshPrecision(precision, [this](auto mesh) {
+    return std::get<MeshParseFunction<decltype(mesh)>>(parseAs) != nullptr;
+  });
+}
+
+bool ParserBackend::supports(MeshPrecision stored, MeshPrecision precision) const
+{
+  return supports(precision) && (narrowsTypes || !isNarrowingConversion(stored, precision));
+}
+
+bool ParserBackend::supports(Format format, const std::optional<PlyHeader> &header) const
+{
+  if (!supports(format)) { return false; }
+  if (!header) { return true; }
+
+  const PlyElement *vertex = header->element("vertex");
+  const PlyElement *face = header->element("face");
+  if (!vertex || !face) { return false; }
+
+  if (!convertsTypes)
+  {
+    for (const char *name : {"x", "y", "z"})
+    {
+      const PlyProperty *property = vertex->property(name);
+      if (!property || property->type != "float") { return false; }
+    }
+    const PlyProperty *indices = face->property("vertex_indices");
+    if (!indices || (indices->type != "int" && indices->type != "uint")) { return false; }
+  }
+
+  if (mapsPropertiesByPosition)
+  {
+    if (vertex->properties.size() < 3 || face->properties.empty()) { return false; }
+    if (vertex->properties[0].name != "x" || vertex->properties[1].name != "y" ||
+        vertex->properties[2].name != "z" || face->properties[0].name != "vertex_indices")
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool WriterBackend::supports(OutputSinkType sink) const
+{
+  return supportsStreams || sink == OutputSinkType::Tmpfs || sink == OutputSinkType::Disk;
+}
+
+const std::vector<ParserBackend> &parserBackends()
+{
+  static const std::vector<ParserBackend> backends{
+      {"hapPLY", "Happly", parseHapply, parseHapply, parseAttributedHapply, parsePolygonHapply,
+       parseSoaHapply,
+       {parseHapplyAs<TriangleMesh>, parseHapplyAs<DoubleTriangleMesh>, parseHapplyAs<UInt32TriangleMesh>,
+        parseHapplyAs<UInt16TriangleMesh>, parseHapplyAs<Int64TriangleMesh>},
+       allFormats, true, false, false},
+      {"MiniPLY", "Miniply", parseMiniply, nullptr, parseAttributedMiniply, parsePolygonMiniply,
+       parseSoaMiniply,
+       {parseMiniplyAs<TriangleMesh>, parseMiniplyAs<DoubleTriangleMesh>, parseMiniplyAs<UInt32TriangleMesh>,
+        parseMiniplyAs<UInt16TriangleMesh>, nullptr},
+       allFormats, true, false, true},
+      {"msh_ply", "MshPly", parseMshPly, nullptr, parseAttributedMshPly, parsePolygonMshPly, parseSoaMshPly,
+       {parseMshPlyAs<TriangleMesh>, parseMshPlyAs<DoubleTriangleMesh>, parseMshPlyAs<UInt32TriangleMesh>,
+        parseMshPlyAs<UInt16TriangleMesh>, nullptr},
+       allFormats, true, false, true},
+      {"nanoply", "NanoPly", parseNanoPly, nullptr, parseAttributedNanoPly, nullptr, nullptr,
+       {parseNanoPlyAs<TriangleMesh>, parseNanoPlyAs<DoubleTriangleMesh>, parseNanoPlyAs<UInt32TriangleMesh>,
+        parseNanoPlyAs<UInt16TriangleMesh>, nullptr},
+       allFormats, true, false, true},
+      {"PLYwoot", "Plywoot", parsePlywoot, parsePlywoot, parseAttributedPlywoot, nullptr, nullptr,
+       {parsePlywootAs<TriangleMesh>, parsePlywootAs<DoubleTriangleMesh>, parsePlywootAs<UInt32TriangleMesh>,
+        parsePlywootAs<UInt16TriangleMesh>, nullptr},
+       allFormats, true, true, true},
+      {"plylib", "PlyLib", parsePlyLib, nullptr, parseAttributedPlyLib, parsePolygonPlyLib, nullptr, {},
+       allFormats, true, false, true},
+      {"RPly", "RPly", parseRPly, parseRPly, parseAttributedRPly, parsePolygonRPly, parseSoaRPly,
+       {parseRPlyAs<TriangleMesh>, parseRPlyAs<DoubleTriangleMesh>, parseRPlyAs<UInt32TriangleMesh>,
+        parseRPlyAs<UInt16TriangleMesh>, parseRPlyAs<Int64TriangleMesh>},
+       allFormats, true, false, true},
+      {"tinyply", "Tinyply", parseTinyply, parseTinyply, parseAttributedTinyply, nullptr, parseSoaTinyply,
+       {parseTinyplyAs<TriangleMesh>, parseTinyplyAs<DoubleTriangleMesh>, parseTinyplyAs<UInt32TriangleMesh>,
+        parseTinyplyAs<UInt16TriangleMesh>, parseTinyplyAs<Int64TriangleMesh>},
+       binaryFormats, false, false, true}};
+  return backends;
+}
+
+const std::vector<WriterBackend> &writerBackends()
+{
+  static const std::vector<WriterBackend> backends{
+      {"hapPLY", "Happly", writeHapply, writeAttributedHapply, writeSoaHapply, writeFormats, true},
+      {"msh_ply", "MshPly", writeMshPly, writeAttributedMshPly, writeSoaMshPly, writeFormats, false},
+      {"nanoply", "NanoPly", writeNanoPly, writeAttributedNanoPly, nullptr, writeFormats, false},
+      {"PLYwoot", "Plywoot", writePlywoot, writeAttributedPlywoot, nullptr, writeFormats, true},
+      {"RPly", "RPly", writeRPly, writeAttributedRPly, writeSoaRPly, writeFormats, true},
+      {"tinyply", "Tinyply", writeTinyply, writeAttributedTinyply, writeSoaTinyply, writeFormats, true}};
+  return backends;
+}
+
+const ParserBackend *findParserBackend(const std::string &benchmarkName)
+{
+  const std::vector<ParserBackend> &backends = parserBackends();
+  auto it = std::find_if(backends.begin(), backends.end(), [&](const ParserBackend &backend) {
+    return backend.benchmarkName == benchmarkName;
+  });
+  return it != backends.end() ? &*it : nullptr;
+}
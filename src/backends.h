@@ -0,0 +1,124 @@
+#pragma once
+
+#include "input_source.h"
+#include "mesh.h"
+#include "output_sink.h"
+#include "util.h"
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using ParseFunction = std::optional<TriangleMesh> (*)(const std::string &);
+
+using InputParseFunction = std::optional<TriangleMesh> (*)(const ParserInput &);
+
+using WriteFunction = bool (*)(const TriangleMesh &, Format, OutputSink &);
+
+using AttributedParseFunction = std::optional<AttributedTriangleMesh> (*)(const std::string &);
+
+using AttributedWriteFunction = bool (*)(const AttributedTriangleMesh &, Format, OutputSink &);
+
+using PolygonParseFunction = std::optional<PolygonMesh> (*)(const std::string &);
+
+using SoaParseFunction = std::optional<SoaTriangleMesh> (*)(const std::string &);
+
+using SoaWriteFunction = bool (*)(const SoaTriangleMesh &, Format, OutputSink &);
+
+template<typename Mesh>
+using MeshParseFunction = std::optional<Mesh> (*)(const std::string &);
+
+// Parse functions for the triangle meshes of all precisions, see
+// `MeshPrecision`; the function for a mesh type is found using `std::get`.
+using PrecisionParseFunctions = std::tuple<
+    MeshParseFunction<TriangleMesh>,
+    MeshParseFunction<DoubleTriangleMesh>,
+    MeshParseFunction<UInt32TriangleMesh>,
+    MeshParseFunction<UInt16TriangleMesh>,
+    MeshParseFunction<Int64TriangleMesh>>;
+
+// Describes the parse adaptor of a PLY library, and what it is able to read.
+struct ParserBackend
+{
+  // Human readable library name, and the suffix used for benchmark names.
+  std::string libraryName;
+  std::string benchmarkName;
+
+  ParseFunction parse;
+  // Parse function for the memory and mmap input sources; only set for
+  // libraries that are able to read from a stream or `FILE` handle.
+  InputParseFunction parseInput;
+  // Parse function for meshes with vertex attributes, which reads the properties
+  // written by `writeMesh()` for an attributed mesh.
+  AttributedParseFunction parseAttributed;
+  // Parse function for meshes with faces of any number of vertices; only set for
+  // libraries that are able to read lists of varying length.
+  PolygonParseFunction parsePolygon;
+  // Parse function for meshes that store their vertices as a structure of
+  // arrays; only set for libraries that are able to fill these arrays directly.
+  SoaParseFunction parseSoa;
+  // Parse functions for triangle meshes of all precisions, which convert from
+  // the types stored in a file; only set for libraries that are able to convert
+  // types. Conversions a library does not support result in an empty optional.
+  // The function for 64-bit indices is only set for libraries that read indices
+  // into 64-bit integers.
+  PrecisionParseFunctions parseAs;
+
+  std::vector<Format> formats;
+
+  // Whether the adaptor converts vertex coordinates and indices of any type;
+  // otherwise it requires `float` coordinates and 32-bit indices.
+  bool convertsTypes;
+
+  // Whether the adaptor maps the leading properties of the vertex and face
+  // elements onto the mesh by position, rather than by name.
+  bool mapsPropertiesByPosition;
+
+  // Whether the parse functions of `parseAs` also convert to narrower types;
+  // otherwise they only convert to wider types.
+  bool narrowsTypes;
+
+  bool supports(InputSource inputSource) const;
+  bool supports(Format format) const;
+  bool supports(MeshPrecision precision) const;
+
+  // Returns whether the adaptor converts models storing the types of the given
+  // precision into meshes of another precision.
+  bool supports(MeshPrecision stored, MeshPrecision precision) const;
+
+  // Returns whether the adaptor is known to support a model in the given format,
+  // using the layout of its header, when available.
+  bool supports(Format format, const std::optional<PlyHeader> &header) const;
+};
+
+// Describes the write adaptor of a PLY library, and what it is able to write.
+struct WriterBackend
+{
+  // Human readable library name, and the suffix used for benchmark names.
+  std::string libraryName;
+  std::string benchmarkName;
+
+  WriteFunction write;
+  AttributedWriteFunction writeAttributed;
+  // Write function for meshes that store their vertices as a structure of
+  // arrays; only set for libraries that are able to write these arrays directly.
+  SoaWriteFunction writeSoa;
+
+  std::vector<Format> formats;
+
+  // Whether the library is able to write to a stream or `FILE` handle, rather
+  // than just to a named file, which is required for the `Memory` and `Discard`
+  // output sinks.
+  bool supportsStreams;
+
+  bool supports(OutputSinkType sink) const;
+};
+
+// All parse and write backends; benchmarks and tests are generated from these,
+// so a new library only needs to be added here.
+const std::vector<ParserBackend> &parserBackends();
+const std::vector<WriterBackend> &writerBackends();
+
+// Returns the parse backend with the given benchmark name, or a null pointer.
+const ParserBackend *findParserBackend(const std::string &benchmarkName);
@@ -0,0 +1,123 @@
+#include "input_source.h"
+
+#include <cstdlib>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::string inputSourceToString(InputSource source)
+{
+  switch (source)
+  {
+    case InputSource::File:
+      return "file";
+    case InputSource::Memory:
+      return "memory";
+    case InputSource::MemoryMap:
+      return "mmap";
+  }
+
+  return {};
+}
+
+MemoryStreamBuf::MemoryStreamBuf(const char *data, std::size_t size)
+{
+  char *begin = const_cast<char *>(data);
+  setg(begin, begin, begin + size);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  if (!(which & std::ios_base::in)) { return pos_type(off_type(-1)); }
+
+  char *base = eback();
+  if (dir == std::ios_base::cur) { base = gptr(); }
+  else if (dir == std::ios_base::end) { base = egptr(); }
+
+  if (base + off < eback() || base + off > egptr()) { return pos_type(off_type(-1)); }
+
+  setg(eback(), base + off, egptr());
+  return pos_type(gptr() - eback());
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+MemoryIStream::MemoryIStream(const char *data, std::size_t size) : std::istream{nullptr}, buffer_{data, size}
+{
+  rdbuf(&buffer_);
+}
+
+ParserInput::ParserInput(InputSource source, std::string filename)
+    : source_{source}, filename_{std::move(filename)}
+{
+  if (source_ == InputSource::File) { return; }
+
+  const int fd = open(filename_.c_str(), O_RDONLY);
+  if (fd == -1) { return; }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+  {
+    const std::size_t size = st.st_size;
+    if (source_ == InputSource::MemoryMap)
+    {
+      void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED)
+      {
+        data_ = static_cast<char *>(data);
+        size_ = size;
+      }
+    }
+    else if ((data_ = static_cast<char *>(std::malloc(size))))
+    {
+      std::size_t offset = 0;
+      while (offset < size)
+      {
+        const ssize_t n = read(fd, data_ + offset, size - offset);
+        if (n <= 0) { break; }
+        offset += n;
+      }
+
+      if (offset == size) { size_ = size; }
+      else
+      {
+        std::free(data_);
+        data_ = nullptr;
+      }
+    }
+  }
+
+  close(fd);
+}
+
+ParserInput::~ParserInput()
+{
+  if (!data_) { return; }
+
+  if (source_ == InputSource::MemoryMap) { munmap(data_, size_); }
+  else { std::free(data_); }
+}
+
+std::unique_ptr<std::istream> ParserInput::stream() const
+{
+  if (source_ == InputSource::File)
+  {
+    return std::make_unique<std::ifstream>(filename_, std::ios::binary);
+  }
+
+  return std::make_unique<MemoryIStream>(data_, size_);
+}
+
+FilePtr ParserInput::file() const
+{
+  FILE *fp = source_ == InputSource::File ? std::fopen(filename_.c_str(), "rb")
+                                          : fmemopen(data_, size_, "rb");
+  return FilePtr{fp, [](FILE *fp) { return fp ? std::fclose(fp) : 0; }};
+}
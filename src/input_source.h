@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+// Ways to feed a PLY file to a parser. For `File`, a parser opens the file by
+// itself, in whatever way the library does that natively. For `Memory`, the
+// file is read into memory up front, so that only decoding is measured. For
+// `MemoryMap`, the file is mapped into memory using `mmap()`.
+enum class InputSource { File, Memory, MemoryMap };
+
+std::string inputSourceToString(InputSource source);
+
+// Read-only stream buffer on top of a contiguous block of memory, which is not
+// copied.
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+  MemoryStreamBuf(const char *data, std::size_t size);
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+// Input stream reading from a contiguous block of memory, which is not copied.
+class MemoryIStream : public std::istream
+{
+public:
+  MemoryIStream(const char *data, std::size_t size);
+
+private:
+  MemoryStreamBuf buffer_;
+};
+
+using FilePtr = std::unique_ptr<FILE, int (*)(FILE *)>;
+
+// Input for a parser from one of the input sources. For the `Memory` and
+// `MemoryMap` sources, the file contents are available through `data()`, and
+// can be read using a stream or a `FILE` handle without any further copies.
+class ParserInput
+{
+public:
+  ParserInput(InputSource source, std::string filename);
+  ~ParserInput();
+
+  ParserInput(const ParserInput &) = delete;
+  ParserInput &operator=(const ParserInput &) = delete;
+
+  // Returns false in case the file could not be read or mapped.
+  bool valid() const { return source_ == InputSource::File || data_ != nullptr; }
+
+  InputSource source() const { return source_; }
+  const std::string &filename() const { return filename_; }
+  std::string_view data() const { return {data_, size_}; }
+
+  // Returns a binary input stream for the file, or for the file contents in
+  // memory.
+  std::unique_ptr<std::istream> stream() const;
+
+  // Returns a `FILE` handle for the file, or for the file contents in memory
+  // using `fmemopen()`. Returns a null handle in case of an error.
+  FilePtr file() const;
+
+private:
+  InputSource source_;
+  std::string filename_;
+  char *data_{nullptr};
+  std::size_t size_{0};
+};
@@ -0,0 +1,48 @@
+#include "latency.h"
+
+#include <algorithm>
+#include <cmath>
+
+LatencyRecorder::LatencyRecorder(std::size_t expectedIterations)
+{
+  samples_.reserve(std::min(expectedIterations, maxReservedIterations));
+}
+
+double LatencyRecorder::percentile(double p)
+{
+  if (samples_.empty()) { return 0; }
+
+  if (!sorted_)
+  {
+    std::sort(samples_.begin(), samples_.end());
+    sorted_ = true;
+  }
+
+  const std::size_t rank = std::max<std::size_t>(1, std::ceil(p / 100 * samples_.size()));
+  return std::chrono::duration<double>(samples_[std::min(rank, samples_.size()) - 1]).count();
+}
+
+std::vector<LatencyRecorder::Bucket> LatencyRecorder::histogram() const
+{
+  std::vector<Bucket> buckets;
+  for (std::uint64_t decade = 1000; decade <= maxUpperBound; decade *= 10)
+  {
+    for (std::uint64_t multiplier : {1, 2, 5})
+    {
+      if (decade * multiplier <= maxUpperBound) { buckets.push_back({decade * multiplier, 0}); }
+    }
+  }
+  buckets.push_back({0, 0});
+
+  for (const Clock::duration &sample : samples_)
+  {
+    const std::uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(sample).count();
+    auto it = std::lower_bound(
+        buckets.begin(), buckets.end() - 1, ns, [](const Bucket &b, std::uint64_t ns) { return b.upperBound < ns; });
+    ++it->count;
+  }
+
+  buckets.erase(
+      std::remove_if(buckets.begin(), buckets.end(), [](const Bucket &b) { return b.count == 0; }), buckets.end());
+  return buckets;
+}
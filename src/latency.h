@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Records the wall time of every iteration of a benchmark, to report tail
+// latencies next to the average time per iteration.
+class LatencyRecorder
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Bucket
+  {
+    // Upper bound of the bucket in nanoseconds, inclusive.
+    std::uint64_t upperBound;
+    std::uint64_t count;
+  };
+
+  // Upper bound of the last bounded histogram bucket in nanoseconds.
+  static constexpr std::uint64_t maxUpperBound = 100'000'000'000;
+
+  // Largest number of iterations to reserve space for, 8 MiB of samples; the
+  // iteration count of Google Benchmark may grow up to a billion.
+  static constexpr std::size_t maxReservedIterations = std::size_t{1} << 20;
+
+  // Reserves space for the given number of iterations up front, up to
+  // `maxReservedIterations`, so that recording does not allocate for all but
+  // the fastest benchmarks.
+  explicit LatencyRecorder(std::size_t expectedIterations);
+
+  void start() { start_ = Clock::now(); }
+  void stop() { samples_.push_back(Clock::now() - start_); }
+
+  bool empty() const { return samples_.empty(); }
+
+  // Returns the given percentile of all recorded times in seconds, using the
+  // nearest rank method, which always returns one of the recorded times.
+  double percentile(double p);
+
+  // Returns the number of recorded times per bucket, for all non-empty buckets.
+  // Bucket bounds follow a 1-2-5 sequence from 1 microsecond up to
+  // `maxUpperBound`; the last bucket has no upper bound, and is reported with an
+  // upper bound of zero.
+  std::vector<Bucket> histogram() const;
+
+private:
+  std::vector<Clock::duration> samples_;
+  bool sorted_{false};
+  Clock::time_point start_;
+};
@@ -0,0 +1,39 @@
+// Minimal executable that parses a single PLY file using one of the PLY
+// libraries, used by the time to mesh benchmarks to measure the latency of a
+// short-lived process that loads a mesh and exits. Once the mesh is loaded, a
+// single byte is written to the file descriptor given on the command line, if
+// any, so that the time to tear down the process is not included.
+#include "backends.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+
+#include <unistd.h>
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3 || argc > 4)
+  {
+    std::cerr << "usage: " << argv[0] << " <library> <filename> [<ready fd>]\n";
+    return 2;
+  }
+
+  const ParserBackend *backend = findParserBackend(argv[1]);
+  if (!backend)
+  {
+    std::cerr << "unknown library '" << argv[1] << "'\n";
+    return 2;
+  }
+
+  const std::optional<TriangleMesh> mesh = backend->parse(argv[2]);
+  if (!mesh) { return 1; }
+
+  if (argc == 4)
+  {
+    const char ready = 1;
+    if (write(std::atoi(argv[3]), &ready, 1) != 1) { return 1; }
+  }
+
+  return 0;
+}
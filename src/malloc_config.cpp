@@ -0,0 +1,132 @@
+#include "malloc_config.h"
+
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+
+#include <malloc.h>
+
+namespace {
+// Arguments of `mallopt()` for every parameter.
+const int mallocOptions[MallocConfig::NumParameters] = {
+    M_MMAP_THRESHOLD, M_TRIM_THRESHOLD, M_TOP_PAD, M_ARENA_MAX, M_MMAP_MAX};
+
+// Default values of every parameter according to mallopt(3); the default arena
+// limit depends on the number of CPU cores, and is left as is.
+const std::optional<int> defaultValues[MallocConfig::NumParameters] = {
+    128 * 1024, 128 * 1024, 128 * 1024, std::nullopt, 65536};
+}
+
+bool MallocConfig::isDefault() const
+{
+  for (const std::optional<int> &value : values)
+  {
+    if (value) { return false; }
+  }
+  return true;
+}
+
+std::string MallocConfig::name() const
+{
+  std::string result;
+  for (int parameter = 0; parameter < NumParameters; ++parameter)
+  {
+    if (!values[parameter]) { continue; }
+    if (!result.empty()) { result += ','; }
+    result += std::string{parameterName(Parameter(parameter))} + '=' + std::to_string(*values[parameter]);
+  }
+  return result.empty() ? "default" : result;
+}
+
+const char *MallocConfig::parameterName(Parameter parameter)
+{
+  switch (parameter)
+  {
+    case MmapThreshold:
+      return "mmap_threshold";
+    case TrimThreshold:
+      return "trim_threshold";
+    case TopPad:
+      return "top_pad";
+    case ArenaMax:
+      return "arena_max";
+    case MmapMax:
+      return "mmap_max";
+    case NumParameters:
+      break;
+  }
+
+  return "";
+}
+
+std::optional<std::vector<MallocConfig>> parseMallocConfigs(const std::string &configs)
+{
+  std::vector<MallocConfig> result;
+
+  std::istringstream iss{configs};
+  std::string config;
+  while (std::getline(iss, config, ';'))
+  {
+    MallocConfig mallocConfig;
+    if (config != "default")
+    {
+      std::istringstream configStream{config};
+      std::string setting;
+      while (std::getline(configStream, setting, ','))
+      {
+        const std::size_t equals = setting.find('=');
+        if (equals == std::string::npos) { return std::nullopt; }
+
+        const std::string name = setting.substr(0, equals);
+        const std::string value = setting.substr(equals + 1);
+
+        char *end = nullptr;
+        const long parsedValue = std::strtol(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0' || parsedValue < 0 || parsedValue > std::numeric_limits<int>::max())
+        {
+          return std::nullopt;
+        }
+
+        bool found = false;
+        for (int parameter = 0; parameter < MallocConfig::NumParameters; ++parameter)
+        {
+          if (name == MallocConfig::parameterName(MallocConfig::Parameter(parameter)))
+          {
+            mallocConfig.values[parameter] = int(parsedValue);
+            found = true;
+          }
+        }
+        if (!found) { return std::nullopt; }
+      }
+    }
+    result.push_back(mallocConfig);
+  }
+
+  return result;
+}
+
+MallocConfigScope::MallocConfigScope(const MallocConfig &config) : config_{config}
+{
+  for (int parameter = 0; parameter < MallocConfig::NumParameters; ++parameter)
+  {
+    if (config_.values[parameter] && mallopt(mallocOptions[parameter], *config_.values[parameter]) != 1)
+    {
+      applied_ = false;
+    }
+  }
+}
+
+MallocConfigScope::~MallocConfigScope()
+{
+  for (int parameter = 0; parameter < MallocConfig::NumParameters; ++parameter)
+  {
+    if (config_.values[parameter] && defaultValues[parameter])
+    {
+      mallopt(mallocOptions[parameter], *defaultValues[parameter]);
+    }
+  }
+
+  // Releases memory retained due to a larger trim threshold or top pad, so that
+  // it does not affect subsequent benchmarks.
+  malloc_trim(0);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Set of glibc malloc parameters, applied using `mallopt()`. Parameters that are
+// not set keep their current value.
+struct MallocConfig
+{
+  enum Parameter { MmapThreshold, TrimThreshold, TopPad, ArenaMax, MmapMax, NumParameters };
+
+  std::array<std::optional<int>, NumParameters> values;
+
+  bool isDefault() const;
+
+  // Returns the name of the configuration as used in benchmark names, like
+  // `mmap_threshold=65536,top_pad=0`, or `default` in case nothing is set.
+  std::string name() const;
+
+  static const char *parameterName(Parameter parameter);
+};
+
+// Parses a semicolon separated list of malloc configurations, each of which is
+// either `default`, or a comma separated list of `<parameter>=<value>` pairs.
+// Returns an empty optional in case the list contains an unknown parameter or
+// an invalid value, including values that do not fit an `int`.
+std::optional<std::vector<MallocConfig>> parseMallocConfigs(const std::string &configs);
+
+// Applies a malloc configuration for as long as the scope exists, and sets the
+// parameters that were changed back to the documented glibc defaults when going
+// out of scope. Note that glibc stops adjusting the mmap threshold dynamically
+// once it is set explicitly, and only applies the arena limit when creating the
+// first secondary arena, so these cannot be fully restored within a process;
+// plybench therefore runs every benchmark in a child process of its own when
+// using malloc configurations.
+class MallocConfigScope
+{
+public:
+  explicit MallocConfigScope(const MallocConfig &config);
+  ~MallocConfigScope();
+
+  // Returns whether glibc accepted all parameters of the configuration;
+  // `mallopt()` leaves a parameter unchanged for values it rejects, like an mmap
+  // threshold above `DEFAULT_MMAP_THRESHOLD_MAX`.
+  bool applied() const { return applied_; }
+
+  MallocConfigScope(const MallocConfigScope &) = delete;
+  MallocConfigScope &operator=(const MallocConfigScope &) = delete;
+
+private:
+  const MallocConfig &config_;
+  bool applied_{true};
+};
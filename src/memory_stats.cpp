@@ -0,0 +1,162 @@
+#include "memory_stats.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <malloc.h>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+std::atomic<bool> tracking{false};
+
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> allocatedBytes{0};
+std::atomic<std::int64_t> liveBytes{0};
+std::atomic<std::int64_t> peakLiveBytes{0};
+
+std::int64_t rssAtBegin{0};
+bool peakRssReset{false};
+
+void recordAllocation(void *ptr)
+{
+  if (!ptr || !tracking.load(std::memory_order_relaxed)) { return; }
+
+  const std::int64_t size = malloc_usable_size(ptr);
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+  const std::int64_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  std::int64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+  while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void recordFree(void *ptr)
+{
+  if (!ptr || !tracking.load(std::memory_order_relaxed)) { return; }
+  liveBytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+}
+
+// Reads a memory size field like `VmRSS` from `/proc/self/status`, in bytes.
+std::optional<std::int64_t> readProcStatus(const char *field)
+{
+  std::FILE *fp = std::fopen("/proc/self/status", "r");
+  if (!fp) { return std::nullopt; }
+
+  std::optional<std::int64_t> result;
+
+  char line[256];
+  const std::size_t fieldLength = std::strlen(field);
+  while (std::fgets(line, sizeof(line), fp))
+  {
+    long long kiB;
+    if (!std::strncmp(line, field, fieldLength) && line[fieldLength] == ':' &&
+        std::sscanf(line + fieldLength + 1, "%lld", &kiB) == 1)
+    {
+      result = kiB * 1024;
+      break;
+    }
+  }
+
+  std::fclose(fp);
+  return result;
+}
+
+// Resets the peak resident set size (VmHWM) of the process to its current
+// resident set size; supported since Linux 4.0.
+bool resetPeakRss()
+{
+  std::FILE *fp = std::fopen("/proc/self/clear_refs", "w");
+  if (!fp) { return false; }
+
+  const bool success = std::fputs("5", fp) >= 0;
+  return std::fclose(fp) == 0 && success;
+}
+}
+
+void beginMemoryStats()
+{
+  allocations = 0;
+  allocatedBytes = 0;
+  liveBytes = 0;
+  peakLiveBytes = 0;
+
+  peakRssReset = resetPeakRss();
+  rssAtBegin = readProcStatus("VmRSS").value_or(0);
+
+  tracking = true;
+}
+
+MemoryStats endMemoryStats()
+{
+  tracking = false;
+
+  MemoryStats stats;
+  stats.allocations = allocations;
+  stats.allocatedBytes = allocatedBytes;
+  stats.peakLiveBytes = peakLiveBytes;
+
+  const std::optional<std::int64_t> peakRss = readProcStatus("VmHWM");
+  if (peakRssReset && peakRss) { stats.peakRssDelta = *peakRss - rssAtBegin; }
+
+  return stats;
+}
+
+extern "C" {
+void *malloc(size_t size)
+{
+  void *ptr = __libc_malloc(size);
+  recordAllocation(ptr);
+  return ptr;
+}
+
+void *calloc(size_t n, size_t size)
+{
+  void *ptr = __libc_calloc(n, size);
+  recordAllocation(ptr);
+  return ptr;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  const std::int64_t oldSize = ptr && tracking.load(std::memory_order_relaxed) ? malloc_usable_size(ptr) : 0;
+  void *newPtr = __libc_realloc(ptr, size);
+  if (newPtr || size == 0)
+  {
+    liveBytes.fetch_sub(oldSize, std::memory_order_relaxed);
+    recordAllocation(newPtr);
+  }
+  return newPtr;
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+  void *ptr = __libc_memalign(alignment, size);
+  recordAllocation(ptr);
+  return ptr;
+}
+
+void *aligned_alloc(size_t alignment, size_t size) { return memalign(alignment, size); }
+
+int posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+  if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) { return EINVAL; }
+
+  *ptr = memalign(alignment, size);
+  return *ptr || size == 0 ? 0 : ENOMEM;
+}
+
+void free(void *ptr)
+{
+  recordFree(ptr);
+  __libc_free(ptr);
+}
+}
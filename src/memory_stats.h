@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+// Heap allocation and resident memory statistics, gathered in between calls to
+// `beginMemoryStats()` and `endMemoryStats()`. Heap allocations are tracked by
+// interposing `malloc()` and friends; this only works for executables that link
+// in `memory_stats.cpp`. Since libstdc++ implements `operator new` and `operator
+// delete` on top of `malloc()` and `free()`, C++ allocations are included.
+struct MemoryStats
+{
+  // Number of allocations, including reallocations.
+  std::uint64_t allocations{0};
+  // Total number of bytes allocated, as reported by `malloc_usable_size()`.
+  std::uint64_t allocatedBytes{0};
+  // Peak number of heap bytes in use, relative to the start of the measurement.
+  std::int64_t peakLiveBytes{0};
+  // Growth of the peak resident set size, in bytes, in case the peak resident
+  // set size could be reset at the start of the measurement.
+  std::optional<std::int64_t> peakRssDelta;
+};
+
+void beginMemoryStats();
+MemoryStats endMemoryStats();
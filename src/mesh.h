@@ -1,38 +1,179 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
-struct Triangle
+template<typename Index>
+struct BasicTriangle
 {
-  std::int32_t a, b, c;
+  Index a, b, c;
 
-  friend bool operator==(const Triangle &x, const Triangle &y)
+  friend bool operator==(const BasicTriangle &x, const BasicTriangle &y)
   {
     return x.a == y.a && x.b == y.b && x.c == y.c;
   }
-  friend bool operator!=(const Triangle &x, const Triangle &y) { return !(x == y); }
+  friend bool operator!=(const BasicTriangle &x, const BasicTriangle &y) { return !(x == y); }
 };
 
-struct Vertex
+template<typename Coordinate>
+struct BasicVertex
 {
-  float x, y, z;
+  Coordinate x, y, z;
 
-  friend bool operator==(const Vertex &v, const Vertex &w) { return v.x == w.x && v.y == w.y && v.z == w.z; }
-  friend bool operator!=(const Vertex &v, const Vertex &w) { return !(v == w); }
+  friend bool operator==(const BasicVertex &v, const BasicVertex &w)
+  {
+    return v.x == w.x && v.y == w.y && v.z == w.z;
+  }
+  friend bool operator!=(const BasicVertex &v, const BasicVertex &w) { return !(v == w); }
 };
 
+// Triangle mesh with vertex coordinates and indices of the given types.
+template<typename CoordinateType, typename IndexType>
+struct BasicTriangleMesh
+{
+  using Coordinate = CoordinateType;
+  using Index = IndexType;
+
+  std::vector<BasicTriangle<Index>> triangles;
+  std::vector<BasicVertex<Coordinate>> vertices;
+
+  friend bool operator==(const BasicTriangleMesh &x, const BasicTriangleMesh &y)
+  {
+    return x.triangles == y.triangles && x.vertices == y.vertices;
+  }
+  friend bool operator!=(const BasicTriangleMesh &x, const BasicTriangleMesh &y) { return !(x == y); }
+};
+
+using Triangle = BasicTriangle<std::int32_t>;
+using Vertex = BasicVertex<float>;
+
 using Triangles = std::vector<Triangle>;
 using Vertices = std::vector<Vertex>;
 
-struct TriangleMesh
+using TriangleMesh = BasicTriangleMesh<float, std::int32_t>;
+
+// Triangle meshes with double precision coordinates, like geodetic scans, and
+// with unsigned 32-bit and 16-bit indices.
+using DoubleTriangleMesh = BasicTriangleMesh<double, std::int32_t>;
+using UInt32TriangleMesh = BasicTriangleMesh<float, std::uint32_t>;
+using UInt16TriangleMesh = BasicTriangleMesh<float, std::uint16_t>;
+
+// Triangle mesh with 64-bit indices, for models with more than 2^31 vertices,
+// like city scale scans.
+using Int64TriangleMesh = BasicTriangleMesh<float, std::int64_t>;
+
+// Vertex positions stored as a structure of arrays, with an array per
+// coordinate, which is the layout preferred by SIMD kernels.
+struct SoaVertices
+{
+  using value_type = Vertex;
+
+  std::vector<float> x, y, z;
+
+  std::size_t size() const { return x.size(); }
+  bool empty() const { return x.empty(); }
+
+  void reserve(std::size_t n)
+  {
+    x.reserve(n);
+    y.reserve(n);
+    z.reserve(n);
+  }
+  void resize(std::size_t n)
+  {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+  }
+
+  Vertex operator[](std::size_t i) const { return Vertex{x[i], y[i], z[i]}; }
+
+  friend bool operator==(const SoaVertices &v, const SoaVertices &w)
+  {
+    return v.x == w.x && v.y == w.y && v.z == w.z;
+  }
+  friend bool operator!=(const SoaVertices &v, const SoaVertices &w) { return !(v == w); }
+};
+
+// Triangle mesh that stores its vertices as a structure of arrays. Triangles are
+// still stored as an array of structures, since all libraries read the indices
+// of a face as a single list.
+struct SoaTriangleMesh
 {
   Triangles triangles;
-  Vertices vertices;
+  SoaVertices vertices;
+
+  friend bool operator==(const SoaTriangleMesh &x, const SoaTriangleMesh &y)
+  {
+    return x.triangles == y.triangles && x.vertices == y.vertices;
+  }
+  friend bool operator!=(const SoaTriangleMesh &x, const SoaTriangleMesh &y) { return !(x == y); }
+};
+
+// Vertex with a normal, an RGBA color and texture coordinates next to its
+// position, stored interleaved like the vertex element of a scanned model.
+struct AttributedVertex
+{
+  float x, y, z;
+  float nx, ny, nz;
+  std::uint8_t red, green, blue, alpha;
+  float u, v;
+
+  friend bool operator==(const AttributedVertex &p, const AttributedVertex &q)
+  {
+    return p.x == q.x && p.y == q.y && p.z == q.z && p.nx == q.nx && p.ny == q.ny && p.nz == q.nz &&
+           p.red == q.red && p.green == q.green && p.blue == q.blue && p.alpha == q.alpha && p.u == q.u &&
+           p.v == q.v;
+  }
+  friend bool operator!=(const AttributedVertex &p, const AttributedVertex &q) { return !(p == q); }
+};
+
+// Names of the float and color properties of an attributed vertex in a PLY
+// file, and the members that store them.
+inline constexpr std::pair<const char *, float AttributedVertex::*> attributedVertexFloatProperties[]{
+    {"x", &AttributedVertex::x},   {"y", &AttributedVertex::y},   {"z", &AttributedVertex::z},
+    {"nx", &AttributedVertex::nx}, {"ny", &AttributedVertex::ny}, {"nz", &AttributedVertex::nz},
+    {"u", &AttributedVertex::u},   {"v", &AttributedVertex::v}};
+inline constexpr std::pair<const char *, std::uint8_t AttributedVertex::*> attributedVertexColorProperties[]{
+    {"red", &AttributedVertex::red},
+    {"green", &AttributedVertex::green},
+    {"blue", &AttributedVertex::blue},
+    {"alpha", &AttributedVertex::alpha}};
 
-  friend bool operator==(const TriangleMesh &x, const TriangleMesh &y)
+using AttributedVertices = std::vector<AttributedVertex>;
+
+struct AttributedTriangleMesh
+{
+  Triangles triangles;
+  AttributedVertices vertices;
+
+  friend bool operator==(const AttributedTriangleMesh &x, const AttributedTriangleMesh &y)
   {
     return x.triangles == y.triangles && x.vertices == y.vertices;
   }
-  friend bool operator!=(const TriangleMesh &x, const TriangleMesh &y) { return !(x == y); }
+  friend bool operator!=(const AttributedTriangleMesh &x, const AttributedTriangleMesh &y)
+  {
+    return !(x == y);
+  }
+};
+
+// Mesh with faces of any number of vertices, stored in compressed sparse row
+// form: the vertex indices of face `i` are stored in `indices`, starting at
+// `offsets[i]` up to `offsets[i + 1]`. Hence, `offsets` always starts with a
+// zero, and contains one more element than there are faces.
+struct PolygonMesh
+{
+  std::vector<std::int32_t> offsets{0};
+  std::vector<std::int32_t> indices;
+  Vertices vertices;
+
+  std::size_t numFaces() const { return offsets.size() - 1; }
+
+  friend bool operator==(const PolygonMesh &x, const PolygonMesh &y)
+  {
+    return x.offsets == y.offsets && x.indices == y.indices && x.vertices == y.vertices;
+  }
+  friend bool operator!=(const PolygonMesh &x, const PolygonMesh &y) { return !(x == y); }
 };
@@ -4,12 +4,21 @@
 
 #include <ostream>
 
-inline std::ostream &operator<<(std::ostream &os, const Triangle &t)
+template<typename Index>
+std::ostream &operator<<(std::ostream &os, const BasicTriangle<Index> &t)
 {
   return os << t.a << ", " << t.b << ", " << t.c;
 }
 
-inline std::ostream &operator<<(std::ostream &os, const Vertex &v)
+template<typename Coordinate>
+std::ostream &operator<<(std::ostream &os, const BasicVertex<Coordinate> &v)
 {
   return os << '(' << v.x << ", " << v.y << ", " << v.z << ')';
 }
+
+inline std::ostream &operator<<(std::ostream &os, const AttributedVertex &v)
+{
+  return os << '(' << v.x << ", " << v.y << ", " << v.z << "), (" << v.nx << ", " << v.ny << ", " << v.nz
+            << "), (" << int(v.red) << ", " << int(v.green) << ", " << int(v.blue) << ", " << int(v.alpha)
+            << "), (" << v.u << ", " << v.v << ')';
+}
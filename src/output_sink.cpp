@@ -0,0 +1,176 @@
+#include "output_sink.h"
+
+#include "util.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace {
+constexpr std::size_t countingBufferSize = 64 * 1024;
+
+ssize_t countWrite(void *cookie, const char *, size_t size)
+{
+  *static_cast<std::size_t *>(cookie) += size;
+  return size;
+}
+}
+
+std::string outputSinkTypeToString(OutputSinkType type)
+{
+  switch (type)
+  {
+    case OutputSinkType::Discard:
+      return "discard";
+    case OutputSinkType::Memory:
+      return "memory";
+    case OutputSinkType::Tmpfs:
+      return "tmpfs";
+    case OutputSinkType::Disk:
+      return "disk";
+  }
+
+  return {};
+}
+
+CountingStreamBuf::CountingStreamBuf() : buffer_(countingBufferSize)
+{
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+}
+
+CountingStreamBuf::int_type CountingStreamBuf::overflow(int_type c)
+{
+  count_ += pptr() - pbase();
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+  if (!traits_type::eq_int_type(c, traits_type::eof())) { sputc(traits_type::to_char_type(c)); }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize CountingStreamBuf::xsputn(const char *s, std::streamsize n)
+{
+  // Large writes bypass the buffer, like they would for a file stream buffer.
+  if (n > epptr() - pptr())
+  {
+    count_ += n;
+    return n;
+  }
+
+  return std::streambuf::xsputn(s, n);
+}
+
+OutputSink::OutputSink(OutputSinkType type, const std::filesystem::path &directory, std::size_t bufferSize)
+    : type_{type}, bufferSize_{bufferSize}
+{
+  if (type_ == OutputSinkType::Tmpfs || type_ == OutputSinkType::Disk) { filename_ = uniquePath(directory); }
+}
+
+OutputSink::~OutputSink()
+{
+  close();
+  std::free(fileData_);
+
+  std::error_code ec;
+  if (!filename_.empty()) { std::filesystem::remove(filename_, ec); }
+}
+
+std::ostream &OutputSink::stream()
+{
+  if (stream_) { return *stream_; }
+
+  switch (type_)
+  {
+    case OutputSinkType::Discard:
+      countingBuf_ = std::make_unique<CountingStreamBuf>();
+      stream_ = std::make_unique<std::ostream>(countingBuf_.get());
+      break;
+    case OutputSinkType::Memory:
+      stream_ = std::make_unique<std::ostringstream>(std::ios::binary);
+      break;
+    case OutputSinkType::Tmpfs:
+    case OutputSinkType::Disk:
+    {
+      // Note that a stream buffer needs to be set before opening the file.
+      auto ofs = std::make_unique<std::ofstream>();
+      if (bufferSize_ > 0)
+      {
+        buffer_.resize(bufferSize_);
+        ofs->rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+      }
+      ofs->open(filename_, std::ios::binary);
+      stream_ = std::move(ofs);
+      break;
+    }
+  }
+
+  return *stream_;
+}
+
+FILE *OutputSink::file()
+{
+  if (file_) { return file_; }
+
+  switch (type_)
+  {
+    case OutputSinkType::Discard:
+      file_ = fopencookie(&fileCount_, "wb", cookie_io_functions_t{nullptr, countWrite, nullptr, nullptr});
+      break;
+    case OutputSinkType::Memory:
+      return file_ = open_memstream(&fileData_, &fileSize_);
+    case OutputSinkType::Tmpfs:
+    case OutputSinkType::Disk:
+      file_ = std::fopen(filename_.c_str(), "wb");
+      break;
+  }
+
+  if (file_ && bufferSize_ > 0) { std::setvbuf(file_, nullptr, _IOFBF, bufferSize_); }
+
+  return file_;
+}
+
+bool OutputSink::close()
+{
+  bool success = true;
+
+  if (stream_)
+  {
+    stream_->flush();
+    success &= bool(*stream_);
+    if (auto ofs = dynamic_cast<std::ofstream *>(stream_.get())) { ofs->close(); }
+  }
+
+  if (file_)
+  {
+    success &= std::fclose(file_) == 0;
+    file_ = nullptr;
+  }
+
+  return success;
+}
+
+std::size_t OutputSink::size() const
+{
+  switch (type_)
+  {
+    case OutputSinkType::Discard:
+      return countingBuf_ ? countingBuf_->count() : fileCount_;
+    case OutputSinkType::Memory:
+      return stream_ ? static_cast<std::ostringstream &>(*stream_).str().size() : fileSize_;
+    case OutputSinkType::Tmpfs:
+    case OutputSinkType::Disk:
+    {
+      std::error_code ec;
+      const std::uintmax_t size = std::filesystem::file_size(filename_, ec);
+      return ec ? 0 : size;
+    }
+  }
+
+  return 0;
+}
+
+std::string OutputSink::data() const
+{
+  if (type_ != OutputSinkType::Memory) { return {}; }
+
+  return stream_ ? static_cast<std::ostringstream &>(*stream_).str() : std::string(fileData_, fileSize_);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Destinations for the output of a writer. `Discard` only counts the number of
+// bytes written, so that only serialization is measured. `Memory` writes to a
+// growable buffer in memory. `Tmpfs` and `Disk` write to a file in a directory
+// on a tmpfs file system and on a disk respectively.
+enum class OutputSinkType { Discard, Memory, Tmpfs, Disk };
+
+std::string outputSinkTypeToString(OutputSinkType type);
+
+// Output stream buffer that discards all data, counting the number of bytes
+// written.
+class CountingStreamBuf : public std::streambuf
+{
+public:
+  CountingStreamBuf();
+
+  std::size_t count() const { return count_ + (pptr() - pbase()); }
+
+protected:
+  int_type overflow(int_type c) override;
+  std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+private:
+  std::vector<char> buffer_;
+  std::size_t count_{0};
+};
+
+// Output for a writer to one of the output sinks; a writer either writes to the
+// sink using a stream, a `FILE` handle, or by opening the file named by
+// `filename()` itself, which is only possible for the `Tmpfs` and `Disk` sinks.
+// A file written by a sink is removed when the sink is destroyed.
+class OutputSink
+{
+public:
+  // Creates a sink writing to a uniquely named file in the given directory for
+  // the `Tmpfs` and `Disk` sinks. The given buffer size is used for the stream
+  // or `FILE` handle, in case it is non-zero; otherwise, the default buffer
+  // size is used.
+  OutputSink(OutputSinkType type, const std::filesystem::path &directory = {}, std::size_t bufferSize = 0);
+  ~OutputSink();
+
+  OutputSink(const OutputSink &) = delete;
+  OutputSink &operator=(const OutputSink &) = delete;
+
+  OutputSinkType type() const { return type_; }
+
+  // Returns the name of the file written to, or an empty path for the
+  // `Discard` and `Memory` sinks.
+  const std::filesystem::path &filename() const { return filename_; }
+
+  std::ostream &stream();
+
+  // Returns a `FILE` handle to write to, or a null pointer in case of an error.
+  // The handle is owned by the sink, and should not be closed.
+  FILE *file();
+
+  // Flushes all data written, and returns false in case of an error.
+  bool close();
+
+  // Returns the number of bytes written, only valid after `close()`.
+  std::size_t size() const;
+
+  // Returns a copy of the data written to a `Memory` sink, only valid after
+  // `close()`.
+  std::string data() const;
+
+private:
+  OutputSinkType type_;
+  std::filesystem::path filename_;
+  std::size_t bufferSize_;
+  std::vector<char> buffer_;
+
+  std::unique_ptr<CountingStreamBuf> countingBuf_;
+  std::unique_ptr<std::ostream> stream_;
+
+  FILE *file_{nullptr};
+  std::size_t fileCount_{0};
+  char *fileData_{nullptr};
+  std::size_t fileSize_{0};
+};
@@ -1,58 +1,424 @@
 #include "parsers.h"
 
 #include "msh_ply.h"
+#include "phases.h"
 
 #include <happly/happly.h>
 #include <miniply/miniply.h>
 #include <plywoot/plywoot.hpp>
 #include <rply/rply.h>
-#include <tinyply/source/example-utils.hpp>
+#include <rply/rplyfile.h>
 #include <tinyply/source/tinyply.h>
 #include <vcglib/wrap/nanoply/include/nanoply.hpp>
 #include <vcglib/wrap/ply/plylib.h>
 
+#include <fstream>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
-std::optional<TriangleMesh> parseHapply(const std::string &filename)
+namespace {
+// Converts hapPLY triangles to mesh triangles.
+template<typename Index = std::int32_t>
+std::vector<BasicTriangle<Index>> convertHapplyTriangles(happly::PLYData &plyIn)
 {
-  // Construct the data object by reading from file
-  happly::PLYData plyIn(filename);
+  std::vector<std::vector<Index>> happlyTriangles = plyIn.getFaceIndices<Index>();
+  std::vector<BasicTriangle<Index>> triangles;
+  triangles.reserve(happlyTriangles.size());
+  std::transform(
+      happlyTriangles.begin(), happlyTriangles.end(), std::back_inserter(triangles),
+      [](const std::vector<Index> &t) {
+        return BasicTriangle<Index>{t[0], t[1], t[2]};
+      });
+  return triangles;
+}
+
+// Converts hapPLY vertices to mesh vertices.
+template<typename Coordinate = float>
+std::optional<std::vector<BasicVertex<Coordinate>>> convertHapplyVertices(happly::PLYData &plyIn)
+{
+  auto &vertexElement = plyIn.getElement("vertex");
+  std::vector<Coordinate> x = vertexElement.getProperty<Coordinate>("x");
+  std::vector<Coordinate> y = vertexElement.getProperty<Coordinate>("y");
+  std::vector<Coordinate> z = vertexElement.getProperty<Coordinate>("z");
+  if (x.size() != y.size() || x.size() != z.size()) { return std::nullopt; }
+
+  std::vector<BasicVertex<Coordinate>> vertices;
+  vertices.reserve(x.size());
+  for (size_t i = 0; i < x.size(); ++i) { vertices.push_back(BasicVertex<Coordinate>{x[i], y[i], z[i]}); }
+  return vertices;
+}
+
+template<typename Mesh = TriangleMesh>
+std::optional<Mesh> convertHapply(happly::PLYData &plyIn)
+{
+  startPhase(Phase::Conversion);
 
   if (!plyIn.hasElement("vertex")) { return std::nullopt; }
 
   if (!plyIn.hasElement("face")) { return std::nullopt; }
 
-  // Convert hapPLY vertices to mesh vertices.
+  auto vertices = convertHapplyVertices<typename Mesh::Coordinate>(plyIn);
+  if (!vertices) { return std::nullopt; }
+
+  return Mesh{convertHapplyTriangles<typename Mesh::Index>(plyIn), std::move(*vertices)};
+}
+
+std::optional<AttributedTriangleMesh> convertAttributedHapply(happly::PLYData &plyIn)
+{
+  startPhase(Phase::Conversion);
+
+  if (!plyIn.hasElement("vertex")) { return std::nullopt; }
+
+  if (!plyIn.hasElement("face")) { return std::nullopt; }
+
+  // hapPLY stores every property in a vector of its own, which are interleaved
+  // into the mesh vertices one property at a time.
   auto &vertexElement = plyIn.getElement("vertex");
-  std::vector<float> x = vertexElement.getProperty<float>("x");
-  std::vector<float> y = vertexElement.getProperty<float>("y");
-  std::vector<float> z = vertexElement.getProperty<float>("z");
-  if (x.size() != y.size() || x.size() != z.size()) { return std::nullopt; }
+  AttributedVertices vertices(vertexElement.count);
+  for (const auto &[name, member] : attributedVertexFloatProperties)
+  {
+    const std::vector<float> values = vertexElement.getProperty<float>(name);
+    if (values.size() != vertices.size()) { return std::nullopt; }
+    for (std::size_t i = 0; i < values.size(); ++i) { vertices[i].*member = values[i]; }
+  }
+  for (const auto &[name, member] : attributedVertexColorProperties)
+  {
+    const std::vector<std::uint8_t> values = vertexElement.getProperty<std::uint8_t>(name);
+    if (values.size() != vertices.size()) { return std::nullopt; }
+    for (std::size_t i = 0; i < values.size(); ++i) { vertices[i].*member = values[i]; }
+  }
 
-  std::vector<Vertex> vertices;
-  vertices.reserve(x.size());
-  for (size_t i = 0; i < x.size(); ++i) { vertices.push_back(Vertex{x[i], y[i], z[i]}); }
+  return AttributedTriangleMesh{convertHapplyTriangles(plyIn), std::move(vertices)};
+}
 
-  // Convert hapPLY triangles to mesh triangles.
-  std::vector<std::vector<std::int32_t>> happlyTriangles = plyIn.getFaceIndices<std::int32_t>();
-  std::vector<Triangle> triangles;
-  triangles.reserve(happlyTriangles.size());
-  std::transform(
-      happlyTriangles.begin(), happlyTriangles.end(), std::back_inserter(triangles),
-      [](const std::vector<std::int32_t> &t) {
-        return Triangle{t[0], t[1], t[2]};
-      });
+using PlywootVertexLayout = plywoot::reflect::Layout<plywoot::reflect::Pack<float, 3>>;
+using PlywootAttributedVertexLayout = plywoot::reflect::Layout<
+    plywoot::reflect::Pack<float, 6>,
+    plywoot::reflect::Pack<std::uint8_t, 4>,
+    plywoot::reflect::Pack<float, 2>>;
+
+template<typename Mesh, typename VertexLayout>
+std::optional<Mesh> readPlywoot(std::istream &is)
+{
+  using MeshVertex = typename decltype(Mesh::vertices)::value_type;
+  using MeshTriangle = typename decltype(Mesh::triangles)::value_type;
+
+  std::vector<MeshTriangle> triangles;
+  std::vector<MeshVertex> vertices;
+
+  startPhase(Phase::Header);
+  plywoot::IStream plyIn{is};
+  startPhase(Phase::Body);
+  while (plyIn.hasElement())
+  {
+    const plywoot::PlyElement element{plyIn.element()};
+    if (element.name() == "vertex") { vertices = plyIn.readElement<MeshVertex, VertexLayout>(); }
+    else if (element.name() == "face")
+    {
+      using TriangleLayout = plywoot::reflect::Layout<plywoot::reflect::Array<decltype(MeshTriangle::a), 3>>;
+      triangles = plyIn.readElement<MeshTriangle, TriangleLayout>();
+    }
+    else { plyIn.skipElement(); }
+  }
 
-  return TriangleMesh{std::move(triangles), std::move(vertices)};
+  startPhase(Phase::Conversion);
+  return Mesh{std::move(triangles), std::move(vertices)};
 }
 
-std::optional<TriangleMesh> parseMiniply(const std::string &filename)
+template<typename Coordinate>
+int readRPlyVertex(p_ply_argument argument)
+{
+  void *pdata;
+  long idata;
+  ply_get_argument_user_data(argument, &pdata, &idata);
+
+  auto *vertices = static_cast<std::vector<BasicVertex<Coordinate>> *>(pdata);
+  const int val_idx = idata;
+
+  const Coordinate value = static_cast<Coordinate>(ply_get_argument_value(argument));
+
+  switch (val_idx)
+  {
+    case 0:
+      vertices->push_back(BasicVertex<Coordinate>{value, 0, 0});
+      break;
+    case 1:
+      vertices->back().y = value;
+      break;
+    case 2:
+      vertices->back().z = value;
+      break;
+  }
+
+  return 1;
+}
+
+// Reads a property of an attributed vertex; the index refers to the float
+// properties first, followed by the color properties. A vertex is added when
+// reading its x coordinate, which is the first property of a vertex.
+int readRPlyAttributedVertex(p_ply_argument argument)
+{
+  void *pdata;
+  long idata;
+  ply_get_argument_user_data(argument, &pdata, &idata);
+
+  AttributedVertices *vertices = static_cast<AttributedVertices *>(pdata);
+  if (idata == 0) { vertices->emplace_back(); }
+
+  const double value = ply_get_argument_value(argument);
+
+  const long numFloatProperties = std::size(attributedVertexFloatProperties);
+  if (idata < numFloatProperties)
+  {
+    vertices->back().*attributedVertexFloatProperties[idata].second = static_cast<float>(value);
+  }
+  else
+  {
+    vertices->back().*attributedVertexColorProperties[idata - numFloatProperties].second =
+        static_cast<std::uint8_t>(value);
+  }
+
+  return 1;
+}
+
+template<typename Coordinate>
+void setRPlyVertexCallbacks(p_ply ply, std::vector<BasicVertex<Coordinate>> &vertices)
+{
+  ply_set_read_cb(ply, "vertex", "x", readRPlyVertex<Coordinate>, &vertices, 0);
+  ply_set_read_cb(ply, "vertex", "y", readRPlyVertex<Coordinate>, &vertices, 1);
+  ply_set_read_cb(ply, "vertex", "z", readRPlyVertex<Coordinate>, &vertices, 2);
+}
+
+// Reads a vertex coordinate into the array of that coordinate.
+int readRPlyCoordinate(p_ply_argument argument)
+{
+  void *pdata;
+  ply_get_argument_user_data(argument, &pdata, NULL);
+
+  std::vector<float> *coordinates = static_cast<std::vector<float> *>(pdata);
+  coordinates->push_back(static_cast<float>(ply_get_argument_value(argument)));
+
+  return 1;
+}
+
+void setRPlyVertexCallbacks(p_ply ply, SoaVertices &vertices)
+{
+  ply_set_read_cb(ply, "vertex", "x", readRPlyCoordinate, &vertices.x, 0);
+  ply_set_read_cb(ply, "vertex", "y", readRPlyCoordinate, &vertices.y, 0);
+  ply_set_read_cb(ply, "vertex", "z", readRPlyCoordinate, &vertices.z, 0);
+}
+
+void setRPlyVertexCallbacks(p_ply ply, AttributedVertices &vertices)
+{
+  long index = 0;
+  for (const auto &[name, member] : attributedVertexFloatProperties)
+  {
+    ply_set_read_cb(ply, "vertex", name, readRPlyAttributedVertex, &vertices, index++);
+  }
+  for (const auto &[name, member] : attributedVertexColorProperties)
+  {
+    ply_set_read_cb(ply, "vertex", name, readRPlyAttributedVertex, &vertices, index++);
+  }
+}
+
+template<typename Index>
+int readRPlyTriangle(p_ply_argument argument)
+{
+  void *pdata;
+  ply_get_argument_user_data(argument, &pdata, NULL);
+
+  auto *triangles = static_cast<std::vector<BasicTriangle<Index>> *>(pdata);
+
+  long length, val_idx;
+  ply_get_argument_property(argument, nullptr, &length, &val_idx);
+
+  const Index value = static_cast<Index>(ply_get_argument_value(argument));
+
+  switch (val_idx)
+  {
+    case 0:
+      triangles->push_back(BasicTriangle<Index>{value, 0, 0});
+      break;
+    case 1:
+      triangles->back().b = value;
+      break;
+    case 2:
+      triangles->back().c = value;
+      break;
+    default:
+      break;
+  }
+
+  return 1;
+}
+
+// Reads a vertex index of a polygon; RPly reports the length of the list of a
+// face first, using a value index of -1.
+int readRPlyPolygon(p_ply_argument argument)
+{
+  void *pdata;
+  ply_get_argument_user_data(argument, &pdata, NULL);
+
+  PolygonMesh *mesh = static_cast<PolygonMesh *>(pdata);
+
+  long length, val_idx;
+  ply_get_argument_property(argument, nullptr, &length, &val_idx);
+
+  if (val_idx < 0) { mesh->offsets.push_back(mesh->offsets.back() + std::int32_t(length)); }
+  else { mesh->indices.push_back(static_cast<std::int32_t>(ply_get_argument_value(argument))); }
+
+  return 1;
+}
+
+template<typename Mesh>
+void reserveRPlyFaces(Mesh &mesh, long n)
+{
+  mesh.triangles.reserve(n);
+}
+
+// Most faces of the generated polygon meshes are quads.
+void reserveRPlyFaces(PolygonMesh &mesh, long n)
+{
+  mesh.offsets.reserve(n + 1);
+  mesh.indices.reserve(4 * n);
+}
+
+template<typename Mesh>
+void setRPlyFaceCallbacks(p_ply ply, Mesh &mesh)
+{
+  using Index = decltype(mesh.triangles[0].a);
+  ply_set_read_cb(ply, "face", "vertex_indices", readRPlyTriangle<Index>, &mesh.triangles, 0);
+}
+
+void setRPlyFaceCallbacks(p_ply ply, PolygonMesh &mesh)
+{
+  ply_set_read_cb(ply, "face", "vertex_indices", readRPlyPolygon, &mesh, 0);
+}
+
+template<typename Mesh>
+std::optional<Mesh> readRPly(p_ply ply)
+{
+  if (!ply) { return std::nullopt; }
+
+  startPhase(Phase::Header);
+  if (!ply_read_header(ply)) { return std::nullopt; }
+
+  Mesh mesh;
+
+  p_ply_element element = nullptr;
+  while ((element = ply_get_next_element(ply, element)))
+  {
+    const char *name;
+    long n;
+    ply_get_element_info(element, &name, &n);
+    if (!strcmp(name, "vertex")) { mesh.vertices.reserve(n); }
+    if (!strcmp(name, "face")) { reserveRPlyFaces(mesh, n); }
+  }
+
+  setRPlyVertexCallbacks(ply, mesh.vertices);
+  setRPlyFaceCallbacks(ply, mesh);
+
+  // Note that RPly converts to a mesh in the read callbacks.
+  startPhase(Phase::Body);
+  if (!ply_read(ply)) { return std::nullopt; }
+
+  ply_close(ply);
+
+  return mesh;
+}
+
+// Returns the miniply type that converts properties to values of the given type.
+template<typename T>
+miniply::PLYPropertyType miniplyType()
+{
+  if constexpr (std::is_same_v<T, float>) { return miniply::PLYPropertyType::Float; }
+  else if constexpr (std::is_same_v<T, double>) { return miniply::PLYPropertyType::Double; }
+  else if constexpr (std::is_same_v<T, std::int32_t>) { return miniply::PLYPropertyType::Int; }
+  else if constexpr (std::is_same_v<T, std::uint32_t>) { return miniply::PLYPropertyType::UInt; }
+  else
+  {
+    static_assert(std::is_same_v<T, std::uint16_t>);
+    return miniply::PLYPropertyType::UShort;
+  }
+}
+
+// Returns the msh_ply type that converts properties to values of the given type.
+template<typename T>
+msh_ply_type_id_t mshPlyType()
+{
+  if constexpr (std::is_same_v<T, float>) { return MSH_PLY_FLOAT; }
+  else if constexpr (std::is_same_v<T, double>) { return MSH_PLY_DOUBLE; }
+  else if constexpr (std::is_same_v<T, std::int32_t>) { return MSH_PLY_INT32; }
+  else if constexpr (std::is_same_v<T, std::uint32_t>) { return MSH_PLY_UINT32; }
+  else
+  {
+    static_assert(std::is_same_v<T, std::uint16_t>);
+    return MSH_PLY_UINT16;
+  }
+}
+
+// Copies `n` values of type `Stored` from the given tinyply buffer, converting
+// them to `T`. Returns false in case the buffer holds a different number of values.
+template<typename Stored, typename T>
+bool convertTinyplyValues(const tinyply::PlyData &data, T *values, std::size_t n)
+{
+  if (data.buffer.size_bytes() != n * sizeof(Stored)) { return false; }
+
+  if constexpr (std::is_same_v<Stored, T>)
+  {
+    std::memcpy(values, data.buffer.get(), data.buffer.size_bytes());
+  }
+  else
+  {
+    const Stored *stored = reinterpret_cast<const Stored *>(data.buffer.get());
+    std::transform(stored, stored + n, values, [](Stored value) { return static_cast<T>(value); });
+  }
+  return true;
+}
+
+// Copies `n` values from the given tinyply buffer, converting them from the type
+// stored in the file, since tinyply does not convert types itself.
+template<typename T>
+bool copyTinyplyValues(const tinyply::PlyData &data, T *values, std::size_t n)
+{
+  switch (data.t)
+  {
+    case tinyply::Type::INT8:
+      return convertTinyplyValues<std::int8_t>(data, values, n);
+    case tinyply::Type::UINT8:
+      return convertTinyplyValues<std::uint8_t>(data, values, n);
+    case tinyply::Type::INT16:
+      return convertTinyplyValues<std::int16_t>(data, values, n);
+    case tinyply::Type::UINT16:
+      return convertTinyplyValues<std::uint16_t>(data, values, n);
+    case tinyply::Type::INT32:
+      return convertTinyplyValues<std::int32_t>(data, values, n);
+    case tinyply::Type::UINT32:
+      return convertTinyplyValues<std::uint32_t>(data, values, n);
+    case tinyply::Type::FLOAT32:
+      return convertTinyplyValues<float>(data, values, n);
+    case tinyply::Type::FLOAT64:
+      return convertTinyplyValues<double>(data, values, n);
+    default:
+      return false;
+  }
+}
+
+// Reads a mesh using miniply, where `extractVertices` extracts the vertices from
+// the vertex element once it is loaded.
+template<typename Mesh, typename ExtractVertices>
+std::optional<Mesh> readMiniply(const std::string &filename, ExtractVertices extractVertices)
 {
+  const PhaseScope phaseScope;
+
   const int verts_per_face = 3;
 
+  // Note that miniply opens the file and parses the header at once.
+  startPhase(Phase::Header);
   miniply::PLYReader reader{filename.data()};
   if (!reader.valid()) { return std::nullopt; }
 
@@ -64,7 +430,7 @@ std::optional<TriangleMesh> parseMiniply(const std::string &filename)
   facesElem->convert_list_to_fixed_size(
       facesElem->find_property("vertex_indices"), verts_per_face, listIdxs.data());
 
-  TriangleMesh mesh;
+  Mesh mesh;
 
   bool gotVerts = false;
   bool gotFaces = false;
@@ -72,36 +438,106 @@ std::optional<TriangleMesh> parseMiniply(const std::string &filename)
   {
     if (!gotVerts && reader.element_is(miniply::kPLYVertexElement))
     {
+      startPhase(Phase::Body);
       if (!reader.load_element()) { return std::nullopt; }
 
-      uint32_t propIdxs[3];
-      if (!reader.find_pos(propIdxs)) { break; }
-      mesh.vertices.resize(reader.num_rows());
-      reader.extract_properties(propIdxs, 3, miniply::PLYPropertyType::Float, mesh.vertices.data());
+      startPhase(Phase::Conversion);
+      if (!extractVertices(reader, mesh.vertices)) { break; }
       gotVerts = true;
     }
     else if (!gotFaces && reader.element_is(miniply::kPLYFaceElement))
     {
+      startPhase(Phase::Body);
       if (!reader.load_element()) { return std::nullopt; }
 
+      startPhase(Phase::Conversion);
       mesh.triangles.resize(reader.num_rows());
       reader.extract_properties(
-          listIdxs.data(), verts_per_face, miniply::PLYPropertyType::Int, mesh.triangles.data());
+          listIdxs.data(), verts_per_face, miniplyType<decltype(mesh.triangles[0].a)>(),
+          mesh.triangles.data());
       gotFaces = true;
     }
+    startPhase(Phase::Body);
     reader.next_element();
   }
 
   return mesh;
 }
+}
 
-std::optional<TriangleMesh> parseMshPly(const std::string &filename)
+template<typename Mesh>
+std::optional<Mesh> parseHapplyAs(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  // Open the file the same way hapPLY does, to be able to time this separately.
+  startPhase(Phase::Open);
+  std::ifstream ifs{filename, std::ios::binary};
+  if (!ifs) { return std::nullopt; }
+
+  // Construct the data object by reading from file
+  startPhase(Phase::Body);
+  happly::PLYData plyIn(ifs);
+
+  // hapPLY only converts properties to wider types, and throws otherwise.
+  try
+  {
+    return convertHapply<Mesh>(plyIn);
+  }
+  catch (const std::runtime_error &)
+  {
+    return std::nullopt;
+  }
+}
+
+std::optional<TriangleMesh> parseHapply(const std::string &filename)
+{
+  return parseHapplyAs<TriangleMesh>(filename);
+}
+
+std::optional<TriangleMesh> parseHapply(const ParserInput &input)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  const std::unique_ptr<std::istream> is{input.stream()};
+  if (!*is) { return std::nullopt; }
+
+  startPhase(Phase::Body);
+  happly::PLYData plyIn(*is);
+  return convertHapply(plyIn);
+}
+
+template<typename Mesh>
+std::optional<Mesh> parseMiniplyAs(const std::string &filename)
+{
+  return readMiniply<Mesh>(filename, [](miniply::PLYReader &reader, auto &vertices) {
+    uint32_t propIdxs[3];
+    if (!reader.find_pos(propIdxs)) { return false; }
+    vertices.resize(reader.num_rows());
+    reader.extract_properties(propIdxs, 3, miniplyType<typename Mesh::Coordinate>(), vertices.data());
+    return true;
+  });
+}
+
+std::optional<TriangleMesh> parseMiniply(const std::string &filename)
+{
+  return parseMiniplyAs<TriangleMesh>(filename);
+}
+
+template<typename Mesh>
+std::optional<Mesh> parseMshPlyAs(const std::string &filename)
 {
+  using MeshVertex = typename decltype(Mesh::vertices)::value_type;
+  using MeshTriangle = typename decltype(Mesh::triangles)::value_type;
+
+  const PhaseScope phaseScope;
+
   const char *vertexProperties[] = {"x", "y", "z"};
   const char *triangleProperties[] = {"vertex_indices"};
 
-  Vertex *vertices;
-  Triangle *triangles;
+  MeshVertex *vertices;
+  MeshTriangle *triangles;
 
   std::int32_t numVertices = 0;
   std::int32_t numTriangles = 0;
@@ -110,7 +546,7 @@ std::optional<TriangleMesh> parseMshPly(const std::string &filename)
   vertexDescriptor.element_name = const_cast<char *>("vertex");
   vertexDescriptor.property_names = vertexProperties;
   vertexDescriptor.num_properties = 3;
-  vertexDescriptor.data_type = MSH_PLY_FLOAT;
+  vertexDescriptor.data_type = mshPlyType<typename Mesh::Coordinate>();
   vertexDescriptor.list_type = MSH_PLY_INVALID;
   vertexDescriptor.data = &vertices;
   vertexDescriptor.list_data = nullptr;
@@ -120,48 +556,67 @@ std::optional<TriangleMesh> parseMshPly(const std::string &filename)
   faceDescriptor.element_name = const_cast<char *>("face");
   faceDescriptor.property_names = triangleProperties;
   faceDescriptor.num_properties = 1;
-  faceDescriptor.data_type = MSH_PLY_INT32;
+  faceDescriptor.data_type = mshPlyType<typename Mesh::Index>();
   faceDescriptor.list_type = MSH_PLY_UINT8;
   faceDescriptor.data = &triangles;
   faceDescriptor.list_data = nullptr;
   faceDescriptor.data_count = &numTriangles;
   faceDescriptor.list_size_hint = 3;
 
+  startPhase(Phase::Open);
   msh_ply_t *plyFile = msh_ply_open(filename.c_str(), "rb");
   if (!plyFile) { return std::nullopt; }
 
+  // Note that msh_ply parses the header as part of reading the body.
+  startPhase(Phase::Body);
   msh_ply_add_descriptor(plyFile, &vertexDescriptor);
   msh_ply_add_descriptor(plyFile, &faceDescriptor);
   msh_ply_read(plyFile);
   msh_ply_close(plyFile);
 
-  auto verticesUptr = std::unique_ptr<Vertex, decltype(&free)>(vertices, free);
-  auto trianglesUPtr = std::unique_ptr<Triangle, decltype(&free)>(triangles, free);
+  startPhase(Phase::Conversion);
+  auto verticesUptr = std::unique_ptr<MeshVertex, decltype(&free)>(vertices, free);
+  auto trianglesUPtr = std::unique_ptr<MeshTriangle, decltype(&free)>(triangles, free);
 
-  return TriangleMesh{
-      Triangles{triangles, triangles + numTriangles}, Vertices{vertices, vertices + numVertices}};
+  return Mesh{{triangles, triangles + numTriangles}, {vertices, vertices + numVertices}};
 }
 
-std::optional<TriangleMesh> parseNanoPly(const std::string &filename)
+std::optional<TriangleMesh> parseMshPly(const std::string &filename)
+{
+  return parseMshPlyAs<TriangleMesh>(filename);
+}
+
+template<typename Mesh>
+std::optional<Mesh> parseNanoPlyAs(const std::string &filename)
 {
+  using MeshVertex = typename decltype(Mesh::vertices)::value_type;
+  using MeshTriangle = typename decltype(Mesh::triangles)::value_type;
+
+  const PhaseScope phaseScope;
+
+  // Note that nanoply opens the file and parses the header at once, and reads
+  // the body directly into the triangle mesh.
+  startPhase(Phase::Header);
   nanoply::Info info(filename);
   if (info.errInfo != nanoply::NNP_OK)
   {
     return std::nullopt;
   }
 
-  TriangleMesh mesh;
+  Mesh mesh;
   mesh.triangles.resize(info.GetFaceCount());
   mesh.vertices.resize(info.GetVertexCount());
 
   nanoply::ElementDescriptor vertexDescriptor(nanoply::NNP_VERTEX_ELEM);
   nanoply::ElementDescriptor faceDescriptor(nanoply::NNP_FACE_ELEM);
-  vertexDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<Vertex, 3, float>(
-      nanoply::NNP_PXYZ, static_cast<void *>(mesh.vertices.data())));
-  faceDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<Triangle, 3, std::int32_t>(
+  vertexDescriptor.dataDescriptor.push_back(
+      new nanoply::DataDescriptor<MeshVertex, 3, typename Mesh::Coordinate>(
+          nanoply::NNP_PXYZ, static_cast<void *>(mesh.vertices.data())));
+  faceDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<MeshTriangle, 3, typename Mesh::Index>(
       nanoply::NNP_FACE_VERTEX_LIST, static_cast<void *>(mesh.triangles.data())));
 
   std::vector<nanoply::ElementDescriptor *> meshDescriptor = {&vertexDescriptor, &faceDescriptor};
+  startPhase(Phase::Body);
   OpenModel(info, meshDescriptor);
 
   for (std::size_t i = 0; i < vertexDescriptor.dataDescriptor.size(); i++)
@@ -176,10 +631,20 @@ std::optional<TriangleMesh> parseNanoPly(const std::string &filename)
   return mesh;
 }
 
+std::optional<TriangleMesh> parseNanoPly(const std::string &filename)
+{
+  return parseNanoPlyAs<TriangleMesh>(filename);
+}
+
 std::optional<TriangleMesh> parsePlyLib(const std::string &filename)
 {
   using namespace vcg::ply;
 
+  const PhaseScope phaseScope;
+
+  // Note that plylib opens the file and parses the header at once, and reads
+  // the body directly into the triangle mesh.
+  startPhase(Phase::Header);
   PlyFile pf;
   pf.Open(filename.c_str(), PlyFile::MODE_READ);
   pf.AddToRead("vertex", "x", T_FLOAT, T_FLOAT, offsetof(Vertex, x), 0, 0, 0, 0, 0);
@@ -187,6 +652,7 @@ std::optional<TriangleMesh> parsePlyLib(const std::string &filename)
   pf.AddToRead("vertex", "z", T_FLOAT, T_FLOAT, offsetof(Vertex, z), 0, 0, 0, 0, 0);
   pf.AddToRead("face", "vertex_indices", T_INT, T_INT, offsetof(Triangle, a), 1, 0, T_UCHAR, T_UCHAR, 0);
 
+  startPhase(Phase::Body);
   TriangleMesh mesh;
 
   for (std::size_t i = 0; i < pf.elements.size(); i++)
@@ -214,144 +680,856 @@ std::optional<TriangleMesh> parsePlyLib(const std::string &filename)
   return mesh;
 }
 
-std::optional<TriangleMesh> parsePlywoot(const std::string &filename)
+template<typename Mesh>
+std::optional<Mesh> parsePlywootAs(const std::string &filename)
 {
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
   std::ifstream ifs{filename};
   if (!ifs) { return std::nullopt; }
 
-  std::vector<Triangle> triangles;
-  std::vector<Vertex> vertices;
-
-  plywoot::IStream plyIn{ifs};
-  while (plyIn.hasElement())
-  {
-    const plywoot::PlyElement element{plyIn.element()};
-    if (element.name() == "vertex")
-    {
-      using VertexLayout = plywoot::reflect::Layout<plywoot::reflect::Pack<float, 3>>;
-      vertices = plyIn.readElement<Vertex, VertexLayout>();
-    }
-    else if (element.name() == "face")
-    {
-      using TriangleLayout = plywoot::reflect::Layout<plywoot::reflect::Array<int, 3>>;
-      triangles = plyIn.readElement<Triangle, TriangleLayout>();
-    }
-    else { plyIn.skipElement(); }
-  }
+  using VertexLayout = plywoot::reflect::Layout<plywoot::reflect::Pack<typename Mesh::Coordinate, 3>>;
+  return readPlywoot<Mesh, VertexLayout>(ifs);
+}
 
-  return TriangleMesh{std::move(triangles), std::move(vertices)};
+std::optional<TriangleMesh> parsePlywoot(const std::string &filename)
+{
+  return parsePlywootAs<TriangleMesh>(filename);
 }
 
-std::optional<TriangleMesh> parseRPly(const std::string &filename)
+std::optional<TriangleMesh> parsePlywoot(const ParserInput &input)
 {
-  p_ply ply = ply_open(filename.c_str(), nullptr, 0, nullptr);
+  const PhaseScope phaseScope;
 
-  if (!ply) { return std::nullopt; }
-  if (!ply_read_header(ply)) { return std::nullopt; }
+  startPhase(Phase::Open);
+  const std::unique_ptr<std::istream> is{input.stream()};
+  if (!*is) { return std::nullopt; }
 
-  TriangleMesh mesh;
+  return readPlywoot<TriangleMesh, PlywootVertexLayout>(*is);
+}
 
-  p_ply_element element = nullptr;
-  while ((element = ply_get_next_element(ply, element)))
-  {
-    const char *name;
-    long n;
-    ply_get_element_info(element, &name, &n);
-    if (!strcmp(name, "vertex")) { mesh.vertices.reserve(n); }
-    if (!strcmp(name, "face")) { mesh.triangles.reserve(n); }
-  }
+template<typename Mesh>
+std::optional<Mesh> parseRPlyAs(const std::string &filename)
+{
+  const PhaseScope phaseScope;
 
-  auto readVertex = [](p_ply_argument argument) {
-    void *pdata;
-    long idata;
-    ply_get_argument_user_data(argument, &pdata, &idata);
+  startPhase(Phase::Open);
+  return readRPly<Mesh>(ply_open(filename.c_str(), nullptr, 0, nullptr));
+}
 
-    TriangleMesh *mesh = static_cast<TriangleMesh *>(pdata);
-    const int val_idx = idata;
+std::optional<TriangleMesh> parseRPly(const std::string &filename)
+{
+  return parseRPlyAs<TriangleMesh>(filename);
+}
 
-    const float value = static_cast<float>(ply_get_argument_value(argument));
+std::optional<TriangleMesh> parseRPly(const ParserInput &input)
+{
+  const PhaseScope phaseScope;
 
-    switch (val_idx)
-    {
-      case 0:
-        mesh->vertices.push_back(Vertex{value, 0, 0});
-        break;
-      case 1:
-        mesh->vertices.back().y = value;
-        break;
-      case 2:
-        mesh->vertices.back().z = value;
-        break;
-    }
+  startPhase(Phase::Open);
+  const FilePtr fp{input.file()};
+  if (!fp) { return std::nullopt; }
 
-    return 1;
-  };
+  return readRPly<TriangleMesh>(ply_open_from_file(fp.get(), nullptr, 0, nullptr));
+}
 
-  auto readTriangle = [](p_ply_argument argument) {
-    void *pdata;
-    ply_get_argument_user_data(argument, &pdata, NULL);
+std::optional<TriangleMesh> parseTinyply(const std::string &filename)
+{
+  const PhaseScope phaseScope;
 
-    TriangleMesh *mesh = static_cast<TriangleMesh *>(pdata);
+  // Note that the whole file is read into memory as part of opening it.
+  startPhase(Phase::Open);
+  return parseTinyply(ParserInput{InputSource::Memory, filename});
+}
 
-    long length, val_idx;
-    ply_get_argument_property(argument, nullptr, &length, &val_idx);
+std::optional<TriangleMesh> parseTinyply(const ParserInput &input)
+{
+  using namespace tinyply;
 
-    const std::int32_t value = static_cast<std::int32_t>(ply_get_argument_value(argument));
+  const PhaseScope phaseScope;
 
-    switch (val_idx)
-    {
-      case 0:
-        mesh->triangles.push_back(Triangle{value, 0, 0});
-        break;
-      case 1:
-        mesh->triangles.back().b = value;
-        break;
-      case 2:
-        mesh->triangles.back().c = value;
-        break;
-      default:
-        break;
-    }
+  startPhase(Phase::Open);
+  const std::unique_ptr<std::istream> is{input.stream()};
+  if (!*is) { return std::nullopt; }
 
-    return 1;
-  };
+  startPhase(Phase::Header);
+  PlyFile file;
+  file.parse_header(*is);
 
-  ply_set_read_cb(ply, "vertex", "x", readVertex, &mesh, 0);
-  ply_set_read_cb(ply, "vertex", "y", readVertex, &mesh, 1);
-  ply_set_read_cb(ply, "vertex", "z", readVertex, &mesh, 2);
-  ply_set_read_cb(ply, "face", "vertex_indices", readTriangle, &mesh, 0);
+  const std::shared_ptr<PlyData> vertices = file.request_properties_from_element("vertex", {"x", "y", "z"});
+  const std::shared_ptr<PlyData> triangles =
+      file.request_properties_from_element("face", {"vertex_indices"}, 3);
 
-  if (!ply_read(ply)) { return std::nullopt; }
+  startPhase(Phase::Body);
+  file.read(*is);
 
-  ply_close(ply);
+  startPhase(Phase::Conversion);
+  TriangleMesh mesh;
+  mesh.vertices.resize(vertices->count);
+  mesh.triangles.resize(triangles->count);
+
+  std::memcpy(mesh.vertices.data(), vertices->buffer.get(), vertices->buffer.size_bytes());
+  std::memcpy(mesh.triangles.data(), triangles->buffer.get(), triangles->buffer.size_bytes());
 
   return mesh;
 }
 
-std::optional<TriangleMesh> parseTinyply(const std::string &filename)
+template<typename Mesh>
+std::optional<Mesh> parseTinyplyAs(const std::string &filename)
 {
   using namespace tinyply;
 
-  std::ifstream ifs(filename);
+  const PhaseScope phaseScope;
 
-  std::vector<uint8_t> buffer = read_file_binary(filename);
-  memory_stream is{(char *)buffer.data(), buffer.size()};
+  startPhase(Phase::Open);
+  const ParserInput input{InputSource::Memory, filename};
+  const std::unique_ptr<std::istream> is{input.stream()};
+  if (!*is) { return std::nullopt; }
 
+  startPhase(Phase::Header);
   PlyFile file;
-  file.parse_header(is);
+  file.parse_header(*is);
 
   const std::shared_ptr<PlyData> vertices = file.request_properties_from_element("vertex", {"x", "y", "z"});
   const std::shared_ptr<PlyData> triangles =
       file.request_properties_from_element("face", {"vertex_indices"}, 3);
 
-  file.read(is);
+  startPhase(Phase::Body);
+  file.read(*is);
 
-  TriangleMesh mesh;
+  // tinyply returns the values using the types stored in the file, so these are
+  // converted here in case they differ from the types of the mesh.
+  startPhase(Phase::Conversion);
+  Mesh mesh;
   mesh.vertices.resize(vertices->count);
   mesh.triangles.resize(triangles->count);
 
-  std::memcpy(mesh.vertices.data(), vertices->buffer.get(), vertices->buffer.size_bytes());
+  using Coordinate = typename Mesh::Coordinate;
+  using Index = typename Mesh::Index;
+  Coordinate *coordinates = reinterpret_cast<Coordinate *>(mesh.vertices.data());
+  Index *indices = reinterpret_cast<Index *>(mesh.triangles.data());
+  if (!copyTinyplyValues(*vertices, coordinates, 3 * vertices->count) ||
+      !copyTinyplyValues(*triangles, indices, 3 * triangles->count))
+  {
+    return std::nullopt;
+  }
+
+  return mesh;
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedHapply(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  std::ifstream ifs{filename, std::ios::binary};
+  if (!ifs) { return std::nullopt; }
+
+  startPhase(Phase::Body);
+  happly::PLYData plyIn(ifs);
+  return convertAttributedHapply(plyIn);
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedMiniply(const std::string &filename)
+{
+  return readMiniply<AttributedTriangleMesh>(
+      filename, [](miniply::PLYReader &reader, AttributedVertices &vertices) {
+        uint32_t floatIdxs[6];
+        uint32_t colorIdxs[4];
+        uint32_t textureIdxs[2];
+        if (!reader.find_properties(floatIdxs, 6, "x", "y", "z", "nx", "ny", "nz") ||
+            !reader.find_properties(colorIdxs, 4, "red", "green", "blue", "alpha") ||
+            !reader.find_properties(textureIdxs, 2, "u", "v"))
+        {
+          return false;
+        }
+
+        // Every group of properties of the same type is extracted straight into
+        // the interleaved vertices.
+        vertices.resize(reader.num_rows());
+        if (!vertices.empty())
+        {
+          const std::uint32_t stride = sizeof(AttributedVertex);
+          reader.extract_properties_with_stride(
+              floatIdxs, 6, miniply::PLYPropertyType::Float, &vertices[0].x, stride);
+          reader.extract_properties_with_stride(
+              colorIdxs, 4, miniply::PLYPropertyType::UChar, &vertices[0].red, stride);
+          reader.extract_properties_with_stride(
+              textureIdxs, 2, miniply::PLYPropertyType::Float, &vertices[0].u, stride);
+        }
+        return true;
+      });
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedMshPly(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  // msh_ply reads every descriptor into an array of its own, hence the float
+  // properties, the colors and the texture coordinates are read separately, and
+  // interleaved afterwards.
+  const char *floatProperties[] = {"x", "y", "z", "nx", "ny", "nz"};
+  const char *colorProperties[] = {"red", "green", "blue", "alpha"};
+  const char *textureProperties[] = {"u", "v"};
+  const char *triangleProperties[] = {"vertex_indices"};
+
+  float *floats = nullptr;
+  std::uint8_t *colors = nullptr;
+  float *textureCoordinates = nullptr;
+  Triangle *triangles = nullptr;
+
+  std::int32_t numFloatVertices = 0;
+  std::int32_t numColorVertices = 0;
+  std::int32_t numTextureVertices = 0;
+  std::int32_t numTriangles = 0;
+
+  auto vertexDescriptor = [](const char **properties,
+                             std::int32_t numProperties,
+                             msh_ply_type_id_t dataType,
+                             void *data,
+                             std::int32_t *count) {
+    msh_ply_desc_t descriptor;
+    descriptor.element_name = const_cast<char *>("vertex");
+    descriptor.property_names = properties;
+    descriptor.num_properties = numProperties;
+    descriptor.data_type = dataType;
+    descriptor.list_type = MSH_PLY_INVALID;
+    descriptor.data = data;
+    descriptor.list_data = nullptr;
+    descriptor.data_count = count;
+    return descriptor;
+  };
+  msh_ply_desc_t floatDescriptor =
+      vertexDescriptor(floatProperties, 6, MSH_PLY_FLOAT, &floats, &numFloatVertices);
+  msh_ply_desc_t colorDescriptor =
+      vertexDescriptor(colorProperties, 4, MSH_PLY_UINT8, &colors, &numColorVertices);
+  msh_ply_desc_t textureDescriptor =
+      vertexDescriptor(textureProperties, 2, MSH_PLY_FLOAT, &textureCoordinates, &numTextureVertices);
+
+  msh_ply_desc_t faceDescriptor;
+  faceDescriptor.element_name = const_cast<char *>("face");
+  faceDescriptor.property_names = triangleProperties;
+  faceDescriptor.num_properties = 1;
+  faceDescriptor.data_type = MSH_PLY_INT32;
+  faceDescriptor.list_type = MSH_PLY_UINT8;
+  faceDescriptor.data = &triangles;
+  faceDescriptor.list_data = nullptr;
+  faceDescriptor.data_count = &numTriangles;
+  faceDescriptor.list_size_hint = 3;
+
+  startPhase(Phase::Open);
+  msh_ply_t *plyFile = msh_ply_open(filename.c_str(), "rb");
+  if (!plyFile) { return std::nullopt; }
+
+  startPhase(Phase::Body);
+  msh_ply_add_descriptor(plyFile, &floatDescriptor);
+  msh_ply_add_descriptor(plyFile, &colorDescriptor);
+  msh_ply_add_descriptor(plyFile, &textureDescriptor);
+  msh_ply_add_descriptor(plyFile, &faceDescriptor);
+  msh_ply_read(plyFile);
+  msh_ply_close(plyFile);
+
+  startPhase(Phase::Conversion);
+  auto floatsUPtr = std::unique_ptr<float, decltype(&free)>(floats, free);
+  auto colorsUPtr = std::unique_ptr<std::uint8_t, decltype(&free)>(colors, free);
+  auto textureCoordinatesUPtr = std::unique_ptr<float, decltype(&free)>(textureCoordinates, free);
+  auto trianglesUPtr = std::unique_ptr<Triangle, decltype(&free)>(triangles, free);
+
+  if (numColorVertices != numFloatVertices || numTextureVertices != numFloatVertices) { return std::nullopt; }
+
+  AttributedVertices vertices(numFloatVertices);
+  for (std::int32_t i = 0; i < numFloatVertices; ++i)
+  {
+    const float *f = floats + 6 * i;
+    const std::uint8_t *c = colors + 4 * i;
+    const float *t = textureCoordinates + 2 * i;
+    vertices[i] = AttributedVertex{f[0], f[1], f[2], f[3], f[4], f[5], c[0], c[1], c[2], c[3], t[0], t[1]};
+  }
+
+  return AttributedTriangleMesh{Triangles{triangles, triangles + numTriangles}, std::move(vertices)};
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedNanoPly(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Header);
+  nanoply::Info info(filename);
+  if (info.errInfo != nanoply::NNP_OK)
+  {
+    return std::nullopt;
+  }
+
+  AttributedTriangleMesh mesh;
+  mesh.triangles.resize(info.GetFaceCount());
+  mesh.vertices.resize(info.GetVertexCount());
+
+  // Every descriptor points to the first member of the vertex it fills, and
+  // strides over the vertices.
+  AttributedVertex *vertices = mesh.vertices.data();
+  nanoply::ElementDescriptor vertexDescriptor(nanoply::NNP_VERTEX_ELEM);
+  nanoply::ElementDescriptor faceDescriptor(nanoply::NNP_FACE_ELEM);
+  if (vertices)
+  {
+    vertexDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<AttributedVertex, 3, float>(
+        nanoply::NNP_PXYZ, static_cast<void *>(&vertices->x)));
+    vertexDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<AttributedVertex, 3, float>(
+        nanoply::NNP_NXYZ, static_cast<void *>(&vertices->nx)));
+    vertexDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<AttributedVertex, 4, unsigned char>(
+        nanoply::NNP_CRGBA, static_cast<void *>(&vertices->red)));
+    vertexDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<AttributedVertex, 2, float>(
+        nanoply::NNP_TEXTURE2D, static_cast<void *>(&vertices->u)));
+  }
+  faceDescriptor.dataDescriptor.push_back(new nanoply::DataDescriptor<Triangle, 3, std::int32_t>(
+      nanoply::NNP_FACE_VERTEX_LIST, static_cast<void *>(mesh.triangles.data())));
+
+  std::vector<nanoply::ElementDescriptor *> meshDescriptor = {&vertexDescriptor, &faceDescriptor};
+  startPhase(Phase::Body);
+  OpenModel(info, meshDescriptor);
+
+  for (std::size_t i = 0; i < vertexDescriptor.dataDescriptor.size(); i++)
+  {
+    delete vertexDescriptor.dataDescriptor[i];
+  }
+  for (std::size_t i = 0; i < faceDescriptor.dataDescriptor.size(); i++)
+  {
+    delete faceDescriptor.dataDescriptor[i];
+  }
+
+  return mesh;
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedPlyLib(const std::string &filename)
+{
+  using namespace vcg::ply;
+
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Header);
+  PlyFile pf;
+  pf.Open(filename.c_str(), PlyFile::MODE_READ);
+  pf.AddToRead("vertex", "x", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, x), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "y", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, y), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "z", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, z), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "nx", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, nx), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "ny", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, ny), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "nz", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, nz), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "red", T_UCHAR, T_UCHAR, offsetof(AttributedVertex, red), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "green", T_UCHAR, T_UCHAR, offsetof(AttributedVertex, green), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "blue", T_UCHAR, T_UCHAR, offsetof(AttributedVertex, blue), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "alpha", T_UCHAR, T_UCHAR, offsetof(AttributedVertex, alpha), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "u", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, u), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "v", T_FLOAT, T_FLOAT, offsetof(AttributedVertex, v), 0, 0, 0, 0, 0);
+  pf.AddToRead("face", "vertex_indices", T_INT, T_INT, offsetof(Triangle, a), 1, 0, T_UCHAR, T_UCHAR, 0);
+
+  startPhase(Phase::Body);
+  AttributedTriangleMesh mesh;
+
+  for (std::size_t i = 0; i < pf.elements.size(); i++)
+  {
+    const std::size_t n = pf.ElemNumber(i);
+
+    if (!strcmp(pf.ElemName(i), "vertex"))
+    {
+      pf.SetCurElement(i);
+
+      mesh.vertices.resize(n);
+      for (std::size_t j = 0; j < n; ++j) { pf.Read(static_cast<void *>(&mesh.vertices[j])); }
+    }
+    else if (!strcmp(pf.ElemName(i), "face"))
+    {
+      pf.SetCurElement(i);
+
+      mesh.triangles.resize(n);
+      for (std::size_t j = 0; j < n; ++j) { pf.Read(static_cast<void *>(&mesh.triangles[j])); }
+    }
+  }
+
+  pf.Destroy();
+
+  return mesh;
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedPlywoot(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  std::ifstream ifs{filename};
+  if (!ifs) { return std::nullopt; }
+
+  return readPlywoot<AttributedTriangleMesh, PlywootAttributedVertexLayout>(ifs);
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedRPly(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  return readRPly<AttributedTriangleMesh>(ply_open(filename.c_str(), nullptr, 0, nullptr));
+}
+
+std::optional<AttributedTriangleMesh> parseAttributedTinyply(const std::string &filename)
+{
+  using namespace tinyply;
+
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  const ParserInput input{InputSource::Memory, filename};
+  const std::unique_ptr<std::istream> is{input.stream()};
+  if (!*is) { return std::nullopt; }
+
+  startPhase(Phase::Header);
+  PlyFile file;
+  file.parse_header(*is);
+
+  // Note that tinyply requires all properties of a request to be of the same
+  // type, and returns every request in a buffer of its own.
+  const std::shared_ptr<PlyData> floats =
+      file.request_properties_from_element("vertex", {"x", "y", "z", "nx", "ny", "nz"});
+  const std::shared_ptr<PlyData> colors =
+      file.request_properties_from_element("vertex", {"red", "green", "blue", "alpha"});
+  const std::shared_ptr<PlyData> textureCoordinates =
+      file.request_properties_from_element("vertex", {"u", "v"});
+  const std::shared_ptr<PlyData> triangles =
+      file.request_properties_from_element("face", {"vertex_indices"}, 3);
+
+  startPhase(Phase::Body);
+  file.read(*is);
+
+  startPhase(Phase::Conversion);
+  if (floats->t != Type::FLOAT32 || colors->t != Type::UINT8 || textureCoordinates->t != Type::FLOAT32 ||
+      colors->count != floats->count || textureCoordinates->count != floats->count)
+  {
+    return std::nullopt;
+  }
+
+  AttributedTriangleMesh mesh;
+  mesh.vertices.resize(floats->count);
+  mesh.triangles.resize(triangles->count);
+
+  const float *f = reinterpret_cast<const float *>(floats->buffer.get());
+  const std::uint8_t *c = colors->buffer.get();
+  const float *t = reinterpret_cast<const float *>(textureCoordinates->buffer.get());
+  for (AttributedVertex &v : mesh.vertices)
+  {
+    v = AttributedVertex{f[0], f[1], f[2], f[3], f[4], f[5], c[0], c[1], c[2], c[3], t[0], t[1]};
+    f += 6;
+    c += 4;
+    t += 2;
+  }
+  std::memcpy(mesh.triangles.data(), triangles->buffer.get(), triangles->buffer.size_bytes());
+
+  return mesh;
+}
+
+std::optional<SoaTriangleMesh> parseSoaHapply(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  std::ifstream ifs{filename, std::ios::binary};
+  if (!ifs) { return std::nullopt; }
+
+  startPhase(Phase::Body);
+  happly::PLYData plyIn(ifs);
+
+  startPhase(Phase::Conversion);
+  if (!plyIn.hasElement("vertex") || !plyIn.hasElement("face")) { return std::nullopt; }
+
+  // hapPLY already stores every property in a vector of its own.
+  auto &vertexElement = plyIn.getElement("vertex");
+  SoaTriangleMesh mesh;
+  mesh.vertices.x = vertexElement.getProperty<float>("x");
+  mesh.vertices.y = vertexElement.getProperty<float>("y");
+  mesh.vertices.z = vertexElement.getProperty<float>("z");
+  if (mesh.vertices.y.size() != mesh.vertices.size() || mesh.vertices.z.size() != mesh.vertices.size())
+  {
+    return std::nullopt;
+  }
+
+  mesh.triangles = convertHapplyTriangles(plyIn);
+  return mesh;
+}
+
+std::optional<SoaTriangleMesh> parseSoaMiniply(const std::string &filename)
+{
+  return readMiniply<SoaTriangleMesh>(filename, [](miniply::PLYReader &reader, SoaVertices &vertices) {
+    uint32_t propIdxs[3];
+    if (!reader.find_pos(propIdxs)) { return false; }
+    vertices.resize(reader.num_rows());
+    reader.extract_properties(&propIdxs[0], 1, miniply::PLYPropertyType::Float, vertices.x.data());
+    reader.extract_properties(&propIdxs[1], 1, miniply::PLYPropertyType::Float, vertices.y.data());
+    reader.extract_properties(&propIdxs[2], 1, miniply::PLYPropertyType::Float, vertices.z.data());
+    return true;
+  });
+}
+
+std::optional<SoaTriangleMesh> parseSoaMshPly(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  // Every coordinate is read using a descriptor of its own, for which msh_ply
+  // allocates a separate array.
+  const char *xProperties[] = {"x"};
+  const char *yProperties[] = {"y"};
+  const char *zProperties[] = {"z"};
+  const char *triangleProperties[] = {"vertex_indices"};
+
+  float *x = nullptr;
+  float *y = nullptr;
+  float *z = nullptr;
+  Triangle *triangles = nullptr;
+
+  std::int32_t numX = 0;
+  std::int32_t numY = 0;
+  std::int32_t numZ = 0;
+  std::int32_t numTriangles = 0;
+
+  auto vertexDescriptor = [](const char **properties, float **data, std::int32_t *count) {
+    msh_ply_desc_t descriptor;
+    descriptor.element_name = const_cast<char *>("vertex");
+    descriptor.property_names = properties;
+    descriptor.num_properties = 1;
+    descriptor.data_type = MSH_PLY_FLOAT;
+    descriptor.list_type = MSH_PLY_INVALID;
+    descriptor.data = data;
+    descriptor.list_data = nullptr;
+    descriptor.data_count = count;
+    return descriptor;
+  };
+  msh_ply_desc_t xDescriptor = vertexDescriptor(xProperties, &x, &numX);
+  msh_ply_desc_t yDescriptor = vertexDescriptor(yProperties, &y, &numY);
+  msh_ply_desc_t zDescriptor = vertexDescriptor(zProperties, &z, &numZ);
+
+  msh_ply_desc_t faceDescriptor;
+  faceDescriptor.element_name = const_cast<char *>("face");
+  faceDescriptor.property_names = triangleProperties;
+  faceDescriptor.num_properties = 1;
+  faceDescriptor.data_type = MSH_PLY_INT32;
+  faceDescriptor.list_type = MSH_PLY_UINT8;
+  faceDescriptor.data = &triangles;
+  faceDescriptor.list_data = nullptr;
+  faceDescriptor.data_count = &numTriangles;
+  faceDescriptor.list_size_hint = 3;
+
+  startPhase(Phase::Open);
+  msh_ply_t *plyFile = msh_ply_open(filename.c_str(), "rb");
+  if (!plyFile) { return std::nullopt; }
+
+  startPhase(Phase::Body);
+  msh_ply_add_descriptor(plyFile, &xDescriptor);
+  msh_ply_add_descriptor(plyFile, &yDescriptor);
+  msh_ply_add_descriptor(plyFile, &zDescriptor);
+  msh_ply_add_descriptor(plyFile, &faceDescriptor);
+  msh_ply_read(plyFile);
+  msh_ply_close(plyFile);
+
+  startPhase(Phase::Conversion);
+  auto xUPtr = std::unique_ptr<float, decltype(&free)>(x, free);
+  auto yUPtr = std::unique_ptr<float, decltype(&free)>(y, free);
+  auto zUPtr = std::unique_ptr<float, decltype(&free)>(z, free);
+  auto trianglesUPtr = std::unique_ptr<Triangle, decltype(&free)>(triangles, free);
+
+  if (numY != numX || numZ != numX) { return std::nullopt; }
+
+  return SoaTriangleMesh{
+      Triangles{triangles, triangles + numTriangles},
+      SoaVertices{{x, x + numX}, {y, y + numY}, {z, z + numZ}}};
+}
+
+std::optional<SoaTriangleMesh> parseSoaRPly(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  return readRPly<SoaTriangleMesh>(ply_open(filename.c_str(), nullptr, 0, nullptr));
+}
+
+std::optional<SoaTriangleMesh> parseSoaTinyply(const std::string &filename)
+{
+  using namespace tinyply;
+
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  const ParserInput input{InputSource::Memory, filename};
+  const std::unique_ptr<std::istream> is{input.stream()};
+  if (!*is) { return std::nullopt; }
+
+  startPhase(Phase::Header);
+  PlyFile file;
+  file.parse_header(*is);
+
+  // Every coordinate is requested separately, so that tinyply returns it in a
+  // buffer of its own.
+  const std::shared_ptr<PlyData> x = file.request_properties_from_element("vertex", {"x"});
+  const std::shared_ptr<PlyData> y = file.request_properties_from_element("vertex", {"y"});
+  const std::shared_ptr<PlyData> z = file.request_properties_from_element("vertex", {"z"});
+  const std::shared_ptr<PlyData> triangles =
+      file.request_properties_from_element("face", {"vertex_indices"}, 3);
+
+  startPhase(Phase::Body);
+  file.read(*is);
+
+  startPhase(Phase::Conversion);
+  if (y->count != x->count || z->count != x->count) { return std::nullopt; }
+
+  SoaTriangleMesh mesh;
+  mesh.vertices.resize(x->count);
+  mesh.triangles.resize(triangles->count);
+
+  std::memcpy(mesh.vertices.x.data(), x->buffer.get(), x->buffer.size_bytes());
+  std::memcpy(mesh.vertices.y.data(), y->buffer.get(), y->buffer.size_bytes());
+  std::memcpy(mesh.vertices.z.data(), z->buffer.get(), z->buffer.size_bytes());
   std::memcpy(mesh.triangles.data(), triangles->buffer.get(), triangles->buffer.size_bytes());
 
   return mesh;
 }
+
+std::optional<PolygonMesh> parsePolygonHapply(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  std::ifstream ifs{filename, std::ios::binary};
+  if (!ifs) { return std::nullopt; }
+
+  startPhase(Phase::Body);
+  happly::PLYData plyIn(ifs);
+
+  startPhase(Phase::Conversion);
+  if (!plyIn.hasElement("vertex") || !plyIn.hasElement("face")) { return std::nullopt; }
+
+  std::optional<Vertices> vertices = convertHapplyVertices(plyIn);
+  if (!vertices) { return std::nullopt; }
+
+  PolygonMesh mesh;
+  mesh.vertices = std::move(*vertices);
+
+  // hapPLY returns the indices of every face in a vector of its own.
+  const std::vector<std::vector<std::int32_t>> faces = plyIn.getFaceIndices<std::int32_t>();
+  mesh.offsets.reserve(faces.size() + 1);
+  for (const std::vector<std::int32_t> &face : faces)
+  {
+    mesh.indices.insert(mesh.indices.end(), face.begin(), face.end());
+    mesh.offsets.push_back(std::int32_t(mesh.indices.size()));
+  }
+
+  return mesh;
+}
+
+std::optional<PolygonMesh> parsePolygonMiniply(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Header);
+  miniply::PLYReader reader{filename.data()};
+  if (!reader.valid()) { return std::nullopt; }
+
+  PolygonMesh mesh;
+
+  bool gotVerts = false;
+  bool gotFaces = false;
+  while (reader.has_element() && (!gotVerts || !gotFaces))
+  {
+    if (!gotVerts && reader.element_is(miniply::kPLYVertexElement))
+    {
+      startPhase(Phase::Body);
+      if (!reader.load_element()) { return std::nullopt; }
+
+      startPhase(Phase::Conversion);
+      uint32_t propIdxs[3];
+      if (!reader.find_pos(propIdxs)) { return std::nullopt; }
+      mesh.vertices.resize(reader.num_rows());
+      reader.extract_properties(propIdxs, 3, miniply::PLYPropertyType::Float, mesh.vertices.data());
+      gotVerts = true;
+    }
+    else if (!gotFaces && reader.element_is(miniply::kPLYFaceElement))
+    {
+      startPhase(Phase::Body);
+      if (!reader.load_element()) { return std::nullopt; }
+
+      // Rather than converting the list to a fixed size, miniply keeps track of
+      // the size of every list, and extracts all indices at once.
+      startPhase(Phase::Conversion);
+      uint32_t propIdx;
+      if (!reader.find_indices(&propIdx)) { return std::nullopt; }
+      const std::uint32_t *listCounts = reader.get_list_counts(propIdx);
+      mesh.offsets.resize(reader.num_rows() + 1);
+      for (std::uint32_t i = 0; i < reader.num_rows(); ++i)
+      {
+        mesh.offsets[i + 1] = mesh.offsets[i] + std::int32_t(listCounts[i]);
+      }
+      mesh.indices.resize(reader.sum_of_list_counts(propIdx));
+      reader.extract_list_property(propIdx, miniply::PLYPropertyType::Int, mesh.indices.data());
+      gotFaces = true;
+    }
+    startPhase(Phase::Body);
+    reader.next_element();
+  }
+
+  return mesh;
+}
+
+std::optional<PolygonMesh> parsePolygonMshPly(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  const char *vertexProperties[] = {"x", "y", "z"};
+  const char *faceProperties[] = {"vertex_indices"};
+
+  Vertex *vertices = nullptr;
+  std::int32_t *indices = nullptr;
+  std::int32_t *faceSizes = nullptr;
+
+  std::int32_t numVertices = 0;
+  std::int32_t numFaces = 0;
+
+  msh_ply_desc_t vertexDescriptor;
+  vertexDescriptor.element_name = const_cast<char *>("vertex");
+  vertexDescriptor.property_names = vertexProperties;
+  vertexDescriptor.num_properties = 3;
+  vertexDescriptor.data_type = MSH_PLY_FLOAT;
+  vertexDescriptor.list_type = MSH_PLY_INVALID;
+  vertexDescriptor.data = &vertices;
+  vertexDescriptor.list_data = nullptr;
+  vertexDescriptor.data_count = &numVertices;
+
+  // Without a list size hint, msh_ply reads lists of any size, storing the
+  // indices of all faces consecutively, and the size of every face separately.
+  msh_ply_desc_t faceDescriptor;
+  faceDescriptor.element_name = const_cast<char *>("face");
+  faceDescriptor.property_names = faceProperties;
+  faceDescriptor.num_properties = 1;
+  faceDescriptor.data_type = MSH_PLY_INT32;
+  faceDescriptor.list_type = MSH_PLY_INT32;
+  faceDescriptor.data = &indices;
+  faceDescriptor.list_data = &faceSizes;
+  faceDescriptor.data_count = &numFaces;
+  faceDescriptor.list_size_hint = 0;
+
+  startPhase(Phase::Open);
+  msh_ply_t *plyFile = msh_ply_open(filename.c_str(), "rb");
+  if (!plyFile) { return std::nullopt; }
+
+  startPhase(Phase::Body);
+  msh_ply_add_descriptor(plyFile, &vertexDescriptor);
+  msh_ply_add_descriptor(plyFile, &faceDescriptor);
+  msh_ply_read(plyFile);
+  msh_ply_close(plyFile);
+
+  startPhase(Phase::Conversion);
+  auto verticesUPtr = std::unique_ptr<Vertex, decltype(&free)>(vertices, free);
+  auto indicesUPtr = std::unique_ptr<std::int32_t, decltype(&free)>(indices, free);
+  auto faceSizesUPtr = std::unique_ptr<std::int32_t, decltype(&free)>(faceSizes, free);
+
+  PolygonMesh mesh;
+  mesh.vertices.assign(vertices, vertices + numVertices);
+  mesh.offsets.resize(numFaces + 1);
+  for (std::int32_t i = 0; i < numFaces; ++i) { mesh.offsets[i + 1] = mesh.offsets[i] + faceSizes[i]; }
+  mesh.indices.assign(indices, indices + mesh.offsets.back());
+
+  return mesh;
+}
+
+std::optional<PolygonMesh> parsePolygonPlyLib(const std::string &filename)
+{
+  using namespace vcg::ply;
+
+  const PhaseScope phaseScope;
+
+  // plylib reads a list into an array of a fixed size, and stores the size of
+  // the list separately, hence every face is read into an array that fits the
+  // longest list, and appended to the mesh.
+  struct Face
+  {
+    std::uint8_t size;
+    std::int32_t indices[255];
+  };
+
+  startPhase(Phase::Header);
+  PlyFile pf;
+  pf.Open(filename.c_str(), PlyFile::MODE_READ);
+  pf.AddToRead("vertex", "x", T_FLOAT, T_FLOAT, offsetof(Vertex, x), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "y", T_FLOAT, T_FLOAT, offsetof(Vertex, y), 0, 0, 0, 0, 0);
+  pf.AddToRead("vertex", "z", T_FLOAT, T_FLOAT, offsetof(Vertex, z), 0, 0, 0, 0, 0);
+  pf.AddToRead(
+      "face", "vertex_indices", T_INT, T_INT, offsetof(Face, indices), 1, 0, T_UCHAR, T_UCHAR,
+      offsetof(Face, size));
+
+  startPhase(Phase::Body);
+  PolygonMesh mesh;
+
+  for (std::size_t i = 0; i < pf.elements.size(); i++)
+  {
+    const std::size_t n = pf.ElemNumber(i);
+
+    if (!strcmp(pf.ElemName(i), "vertex"))
+    {
+      pf.SetCurElement(i);
+
+      mesh.vertices.resize(n);
+      for (std::size_t j = 0; j < n; ++j) { pf.Read(static_cast<void *>(&mesh.vertices[j])); }
+    }
+    else if (!strcmp(pf.ElemName(i), "face"))
+    {
+      pf.SetCurElement(i);
+
+      mesh.offsets.reserve(n + 1);
+      Face face;
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        pf.Read(static_cast<void *>(&face));
+        mesh.indices.insert(mesh.indices.end(), face.indices, face.indices + face.size);
+        mesh.offsets.push_back(std::int32_t(mesh.indices.size()));
+      }
+    }
+  }
+
+  pf.Destroy();
+
+  return mesh;
+}
+
+std::optional<PolygonMesh> parsePolygonRPly(const std::string &filename)
+{
+  const PhaseScope phaseScope;
+
+  startPhase(Phase::Open);
+  return readRPly<PolygonMesh>(ply_open(filename.c_str(), nullptr, 0, nullptr));
+}
+
+template std::optional<TriangleMesh> parseHapplyAs(const std::string &);
+template std::optional<DoubleTriangleMesh> parseHapplyAs(const std::string &);
+template std::optional<UInt32TriangleMesh> parseHapplyAs(const std::string &);
+template std::optional<UInt16TriangleMesh> parseHapplyAs(const std::string &);
+template std::optional<Int64TriangleMesh> parseHapplyAs(const std::string &);
+template std::optional<TriangleMesh> parseMiniplyAs(const std::string &);
+template std::optional<DoubleTriangleMesh> parseMiniplyAs(const std::string &);
+template std::optional<UInt32TriangleMesh> parseMiniplyAs(const std::string &);
+template std::optional<UInt16TriangleMesh> parseMiniplyAs(const std::string &);
+template std::optional<TriangleMesh> parseMshPlyAs(const std::string &);
+template std::optional<DoubleTriangleMesh> parseMshPlyAs(const std::string &);
+template std::optional<UInt32TriangleMesh> parseMshPlyAs(const std::string &);
+template std::optional<UInt16TriangleMesh> parseMshPlyAs(const std::string &);
+template std::optional<TriangleMesh> parseNanoPlyAs(const std::string &);
+template std::optional<DoubleTriangleMesh> parseNanoPlyAs(const std::string &);
+template std::optional<UInt32TriangleMesh> parseNanoPlyAs(const std::string &);
+template std::optional<UInt16TriangleMesh> parseNanoPlyAs(const std::string &);
+template std::optional<TriangleMesh> parsePlywootAs(const std::string &);
+template std::optional<DoubleTriangleMesh> parsePlywootAs(const std::string &);
+template std::optional<UInt32TriangleMesh> parsePlywootAs(const std::string &);
+template std::optional<UInt16TriangleMesh> parsePlywootAs(const std::string &);
+template std::optional<TriangleMesh> parseRPlyAs(const std::string &);
+template std::optional<DoubleTriangleMesh> parseRPlyAs(const std::string &);
+template std::optional<UInt32TriangleMesh> parseRPlyAs(const std::string &);
+template std::optional<UInt16TriangleMesh> parseRPlyAs(const std::string &);
+template std::optional<Int64TriangleMesh> parseRPlyAs(const std::string &);
+template std::optional<TriangleMesh> parseTinyplyAs(const std::string &);
+template std::optional<DoubleTriangleMesh> parseTinyplyAs(const std::string &);
+template std::optional<UInt32TriangleMesh> parseTinyplyAs(const std::string &);
+template std::optional<UInt16TriangleMesh> parseTinyplyAs(const std::string &);
+template std::optional<Int64TriangleMesh> parseTinyplyAs(const std::string &);
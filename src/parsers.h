@@ -1,5 +1,6 @@
 #pragma once
 
+#include "input_source.h"
 #include "mesh.h"
 
 #include <optional>
@@ -13,3 +14,63 @@ std::optional<TriangleMesh> parsePlyLib(const std::string &filename);
 std::optional<TriangleMesh> parsePlywoot(const std::string &filename);
 std::optional<TriangleMesh> parseRPly(const std::string &filename);
 std::optional<TriangleMesh> parseTinyply(const std::string &filename);
+
+// Parsers for triangle meshes with other coordinate and index types than
+// `TriangleMesh`, which convert from the types stored in a file where needed,
+// using the conversions a library offers, or after reading for tinyply, which
+// does not convert. These return an empty optional in case a library is unable
+// to convert, and are defined for `TriangleMesh`, `DoubleTriangleMesh`,
+// `UInt32TriangleMesh` and `UInt16TriangleMesh`; they only read from a file.
+// hapPLY, RPly and tinyply also read indices into an `Int64TriangleMesh`; the
+// other libraries have no 64-bit integer type to convert to. plylib is missing,
+// since it requires the stored types to be known up front.
+template<typename Mesh>
+std::optional<Mesh> parseHapplyAs(const std::string &filename);
+template<typename Mesh>
+std::optional<Mesh> parseMiniplyAs(const std::string &filename);
+template<typename Mesh>
+std::optional<Mesh> parseMshPlyAs(const std::string &filename);
+template<typename Mesh>
+std::optional<Mesh> parseNanoPlyAs(const std::string &filename);
+template<typename Mesh>
+std::optional<Mesh> parsePlywootAs(const std::string &filename);
+template<typename Mesh>
+std::optional<Mesh> parseRPlyAs(const std::string &filename);
+template<typename Mesh>
+std::optional<Mesh> parseTinyplyAs(const std::string &filename);
+
+// Parsers for the libraries that can read from an arbitrary stream or `FILE`
+// handle, and hence from all input sources.
+std::optional<TriangleMesh> parseHapply(const ParserInput &input);
+std::optional<TriangleMesh> parsePlywoot(const ParserInput &input);
+std::optional<TriangleMesh> parseRPly(const ParserInput &input);
+std::optional<TriangleMesh> parseTinyply(const ParserInput &input);
+
+// Parsers for meshes with vertex normals, colors and texture coordinates, see
+// `AttributedVertex`; these only read from a file.
+std::optional<AttributedTriangleMesh> parseAttributedHapply(const std::string &filename);
+std::optional<AttributedTriangleMesh> parseAttributedMiniply(const std::string &filename);
+std::optional<AttributedTriangleMesh> parseAttributedMshPly(const std::string &filename);
+std::optional<AttributedTriangleMesh> parseAttributedNanoPly(const std::string &filename);
+std::optional<AttributedTriangleMesh> parseAttributedPlyLib(const std::string &filename);
+std::optional<AttributedTriangleMesh> parseAttributedPlywoot(const std::string &filename);
+std::optional<AttributedTriangleMesh> parseAttributedRPly(const std::string &filename);
+std::optional<AttributedTriangleMesh> parseAttributedTinyply(const std::string &filename);
+
+// Parsers for meshes that store their vertices as a structure of arrays, see
+// `SoaTriangleMesh`, for the libraries that are able to fill the array of every
+// coordinate directly; these only read from a file.
+std::optional<SoaTriangleMesh> parseSoaHapply(const std::string &filename);
+std::optional<SoaTriangleMesh> parseSoaMiniply(const std::string &filename);
+std::optional<SoaTriangleMesh> parseSoaMshPly(const std::string &filename);
+std::optional<SoaTriangleMesh> parseSoaRPly(const std::string &filename);
+std::optional<SoaTriangleMesh> parseSoaTinyply(const std::string &filename);
+
+// Parsers for meshes with faces of any number of vertices, see `PolygonMesh`,
+// for the libraries that are able to read lists of varying length; these only
+// read from a file.
+std::optional<PolygonMesh> parsePolygonHapply(const std::string &filename);
+std::optional<PolygonMesh> parsePolygonMiniply(const std::string &filename);
+std::optional<PolygonMesh> parsePolygonMshPly(const std::string &filename);
+std::optional<PolygonMesh> parsePolygonPlyLib(const std::string &filename);
+std::optional<PolygonMesh> parsePolygonRPly(const std::string &filename);
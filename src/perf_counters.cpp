@@ -0,0 +1,124 @@
+#include "perf_counters.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+int openEvent(std::uint32_t type, std::uint64_t config)
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+constexpr std::uint64_t cacheReadMiss(std::uint64_t cache)
+{
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+}
+
+PerfCounters::PerfCounters()
+{
+  fds_[Cycles] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[Instructions] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[BranchMisses] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  fds_[L1dMisses] = openEvent(PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_L1D));
+  fds_[LlcMisses] = openEvent(PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_LL));
+  fds_[DtlbMisses] = openEvent(PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_DTLB));
+}
+
+PerfCounters::~PerfCounters()
+{
+  for (int fd : fds_)
+  {
+    if (fd >= 0) { close(fd); }
+  }
+}
+
+bool PerfCounters::available() const
+{
+  for (int fd : fds_)
+  {
+    if (fd >= 0) { return true; }
+  }
+  return false;
+}
+
+void PerfCounters::start()
+{
+  for (int fd : fds_)
+  {
+    if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_RESET, 0); }
+  }
+  resume();
+}
+
+void PerfCounters::pause()
+{
+  for (int fd : fds_)
+  {
+    if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_DISABLE, 0); }
+  }
+}
+
+void PerfCounters::resume()
+{
+  for (int fd : fds_)
+  {
+    if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); }
+  }
+}
+
+PerfCounters::Values PerfCounters::stop()
+{
+  pause();
+
+  Values values;
+  for (int event = 0; event < NumEvents; ++event)
+  {
+    // Layout as determined by the read format that was requested.
+    std::uint64_t data[3];
+    if (fds_[event] >= 0 && read(fds_[event], data, sizeof(data)) == sizeof(data) && data[2] > 0)
+    {
+      values[event] = double(data[0]) * data[1] / data[2];
+    }
+  }
+
+  return values;
+}
+
+const char *PerfCounters::eventName(Event event)
+{
+  switch (event)
+  {
+    case Cycles:
+      return "cycles";
+    case Instructions:
+      return "instructions";
+    case BranchMisses:
+      return "branch_misses";
+    case L1dMisses:
+      return "l1d_misses";
+    case LlcMisses:
+      return "llc_misses";
+    case DtlbMisses:
+      return "dtlb_misses";
+    case NumEvents:
+      break;
+  }
+
+  return "";
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <optional>
+
+// Hardware performance counters for the calling thread, based on
+// `perf_event_open()`. Only user space events are counted. Events that are not
+// supported by the hardware or the kernel, or that are not accessible due to
+// the `perf_event_paranoid` setting, are not reported.
+class PerfCounters
+{
+public:
+  enum Event { Cycles, Instructions, BranchMisses, L1dMisses, LlcMisses, DtlbMisses, NumEvents };
+
+  using Values = std::array<std::optional<double>, NumEvents>;
+
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  // Returns whether at least one of the events could be opened.
+  bool available() const;
+
+  // Resets all counters to zero, and starts counting.
+  void start();
+  void pause();
+  void resume();
+
+  // Stops counting, and returns the counter values, scaled to compensate for
+  // multiplexing in case there are fewer hardware counters than events.
+  Values stop();
+
+  static const char *eventName(Event event);
+
+private:
+  std::array<int, NumEvents> fds_;
+};
@@ -0,0 +1,55 @@
+#include "phases.h"
+
+namespace {
+thread_local PhaseRecorder *currentRecorder = nullptr;
+}
+
+const char *phaseToString(Phase phase)
+{
+  switch (phase)
+  {
+    case Phase::Open:
+      return "open";
+    case Phase::Header:
+      return "header";
+    case Phase::Body:
+      return "body";
+    case Phase::Conversion:
+      return "conversion";
+  }
+
+  return "";
+}
+
+PhaseRecorder::PhaseRecorder() : previous_{currentRecorder} { currentRecorder = this; }
+
+PhaseRecorder::~PhaseRecorder() { currentRecorder = previous_; }
+
+void PhaseRecorder::start(Phase phase)
+{
+  stop();
+
+  phase_ = phase;
+  start_ = Clock::now();
+}
+
+void PhaseRecorder::stop()
+{
+  if (!phase_) { return; }
+
+  const Clock::time_point now = Clock::now();
+  totals_[int(*phase_)] += std::chrono::duration<double>(now - start_).count();
+  if (recordEvents_) { events_.push_back(Event{*phase_, start_, now}); }
+
+  phase_.reset();
+}
+
+void startPhase(Phase phase)
+{
+  if (currentRecorder) { currentRecorder->start(phase); }
+}
+
+PhaseScope::~PhaseScope()
+{
+  if (currentRecorder) { currentRecorder->stop(); }
+}
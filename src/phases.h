@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+// Phases of parsing a PLY file. A library that does not expose a phase
+// separately attributes its time to the next phase; hapPLY, for example, parses
+// the header while decoding the body.
+enum class Phase { Open, Header, Body, Conversion };
+
+constexpr int numPhases = 4;
+
+const char *phaseToString(Phase phase);
+
+// Records the time spent in every phase by the calling thread for as long as the
+// recorder exists; the parse adaptors mark the start of every phase using
+// `startPhase()`. Without a recorder, marking a phase does nothing.
+class PhaseRecorder
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Event
+  {
+    Phase phase;
+    Clock::time_point start;
+    Clock::time_point end;
+  };
+
+  PhaseRecorder();
+  ~PhaseRecorder();
+
+  PhaseRecorder(const PhaseRecorder &) = delete;
+  PhaseRecorder &operator=(const PhaseRecorder &) = delete;
+
+  // Ends the current phase, if any, and starts the given phase.
+  void start(Phase phase);
+
+  // Ends the current phase, if any.
+  void stop();
+
+  // Enables recording every phase as an individual event, next to the totals.
+  void recordEvents(bool enabled) { recordEvents_ = enabled; }
+
+  const std::vector<Event> &events() const { return events_; }
+
+  // Returns the total time in seconds spent in every phase.
+  const std::array<double, numPhases> &totals() const { return totals_; }
+
+private:
+  PhaseRecorder *previous_;
+
+  std::optional<Phase> phase_;
+  Clock::time_point start_;
+
+  bool recordEvents_{false};
+  std::vector<Event> events_;
+  std::array<double, numPhases> totals_{};
+};
+
+// Starts the given phase for the phase recorder of the calling thread, if any.
+void startPhase(Phase phase);
+
+// Ends the current phase for the phase recorder of the calling thread, if any,
+// when going out of scope, so that the time spent in the caller after parsing is
+// not attributed to the last phase.
+class PhaseScope
+{
+public:
+  PhaseScope() = default;
+  ~PhaseScope();
+
+  PhaseScope(const PhaseScope &) = delete;
+  PhaseScope &operator=(const PhaseScope &) = delete;
+};
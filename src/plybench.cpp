@@ -1,236 +1,1954 @@
+#include "backends.h"
+#include "input_source.h"
+#include "latency.h"
+#include "malloc_config.h"
+#include "memory_stats.h"
 #include "mesh.h"
+#include "output_sink.h"
 #include "parsers.h"
+#include "perf_counters.h"
+#include "phases.h"
+#include "reporters.h"
+#include "syscall_stats.h"
 #include "util.h"
 #include "writers.h"
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace {
-constexpr std::int32_t writeNumTriangles = 100000;
+// Type of the vertices of the given mesh type.
+template<typename Mesh>
+using MeshVertex = typename decltype(Mesh::vertices)::value_type;
+
+// Type of the triangles of the given mesh type.
+template<typename Mesh>
+using MeshTriangle = typename decltype(Mesh::triangles)::value_type;
 
-std::size_t meshSizeInBytes(const TriangleMesh &mesh)
+// Returns the mesh written by the write benchmarks for the given number of
+// triangles. Only the most recently created mesh is cached, to limit memory
+// usage for the larger meshes in the size sweep. Since the normals of the
+// degenerate triangles of a strip are undefined, attributed meshes are grids.
+template<typename Mesh>
+const Mesh &writeBenchmarkMesh(std::int64_t numTriangles)
 {
-  return mesh.triangles.size() * sizeof(Triangle) + mesh.vertices.size() * sizeof(Vertex);
+  static std::optional<Mesh> mesh;
+  if (!mesh || std::int64_t(mesh->triangles.size()) != numTriangles)
+  {
+    mesh.reset();
+    if constexpr (std::is_same_v<Mesh, AttributedTriangleMesh>)
+    {
+      mesh = createAttributedMesh(MeshShape::NoisyGrid, numTriangles);
+    }
+    else if constexpr (std::is_same_v<Mesh, SoaTriangleMesh>)
+    {
+      mesh = toStructureOfArrays(createMesh(numTriangles));
+    }
+    else { mesh = createMesh(numTriangles); }
+  }
+  return *mesh;
 }
+
+// Returns a geometric sequence of mesh sizes from `min` up to and including
+// `max`, where each size is `multiplier` times the previous size.
+std::vector<std::int64_t> sweepSizes(std::int64_t min, std::int64_t max, std::int64_t multiplier)
+{
+  std::vector<std::int64_t> sizes;
+  for (std::int64_t size = min; size > 0 && size < max; size *= std::max<std::int64_t>(2, multiplier))
+  {
+    sizes.push_back(size);
+  }
+  if (max > 0) { sizes.push_back(max); }
+  return sizes;
 }
 
-static void BM_ParseHapply(benchmark::State &state, const std::string &filename)
+// Parses a comma separated list of mesh shape names; spaces in shape names may
+// be replaced by underscores.
+std::vector<MeshShape> parseMeshShapes(const std::string &names)
 {
-  benchmark::ClobberMemory();
+  std::vector<MeshShape> shapes;
 
-  std::optional<TriangleMesh> maybeMesh;
-  for (auto _ : state)
+  std::istringstream iss{names};
+  std::string name;
+  while (std::getline(iss, name, ','))
   {
-    if (!(maybeMesh = parseHapply(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with hapPLY").data());
-    benchmark::DoNotOptimize(maybeMesh);
+    std::replace(name.begin(), name.end(), '_', ' ');
+    for (MeshShape shape : corpusMeshShapes)
+    {
+      if (!strcasecmp(name.c_str(), meshShapeToString(shape).c_str())) { shapes.push_back(shape); }
+    }
   }
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  return shapes;
 }
 
-static void BM_WriteHapply(benchmark::State &state, Format format)
+// Parses a comma separated list of input source names.
+std::vector<InputSource> parseInputSources(const std::string &names)
 {
-  benchmark::ClobberMemory();
+  std::vector<InputSource> sources;
 
-  const TriangleMesh mesh{createMesh(writeNumTriangles)};
-  for (auto _ : state) { writeHapply(mesh, format); }
+  std::istringstream iss{names};
+  std::string name;
+  while (std::getline(iss, name, ','))
+  {
+    for (InputSource source : {InputSource::File, InputSource::Memory, InputSource::MemoryMap})
+    {
+      if (!strcasecmp(name.c_str(), inputSourceToString(source).c_str())) { sources.push_back(source); }
+    }
+  }
 
-  state.SetBytesProcessed(state.iterations() * meshSizeInBytes(mesh));
+  return sources;
 }
 
-static void BM_ParseMiniply(benchmark::State &state, const std::string &filename)
+// Parses a comma separated list of output sink names.
+std::vector<OutputSinkType> parseOutputSinks(const std::string &names)
 {
-  benchmark::ClobberMemory();
+  std::vector<OutputSinkType> sinks;
 
-  std::optional<TriangleMesh> maybeMesh;
-  for (auto _ : state)
+  std::istringstream iss{names};
+  std::string name;
+  while (std::getline(iss, name, ','))
   {
-    if (!(maybeMesh = parseMiniply(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with MiniPLY").data());
+    for (OutputSinkType sink :
+         {OutputSinkType::Discard, OutputSinkType::Memory, OutputSinkType::Tmpfs, OutputSinkType::Disk})
+    {
+      if (!strcasecmp(name.c_str(), outputSinkTypeToString(sink).c_str())) { sinks.push_back(sink); }
+    }
   }
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  return sinks;
 }
 
-static void BM_ParseMshPly(benchmark::State &state, const std::string &filename)
+// Extracts the value of a command line flag of the form `<flag>=value`, and
+// removes the flag from the argument list.
+std::optional<std::string> extractArgument(int &argc, char *argv[], const std::string &flag)
 {
-  benchmark::ClobberMemory();
+  const std::string prefix = flag + '=';
 
-  std::optional<TriangleMesh> maybeMesh;
-  for (auto _ : state)
+  std::optional<std::string> value;
+  for (int i = 1; i < argc; ++i)
   {
-    if (!(maybeMesh = parseMshPly(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with msh_ply").data());
+    if (!std::strncmp(argv[i], prefix.c_str(), prefix.size()))
+    {
+      value = argv[i] + prefix.size();
+      std::copy(argv + i + 1, argv + argc, argv + i);
+      --argc;
+      --i;
+    }
   }
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  return value;
 }
 
-static void BM_WriteMshPly(benchmark::State &state, Format format)
+// Extracts the value of a command line flag of the form `--plybench_<name>=value`,
+// and removes the flag from the argument list, so that the remaining arguments
+// can be validated by Google Benchmark.
+std::optional<std::string> extractFlag(int &argc, char *argv[], const std::string &name)
 {
-  benchmark::ClobberMemory();
+  return extractArgument(argc, argv, "--plybench_" + name);
+}
+
+template<typename Mesh>
+std::size_t meshSizeInBytes(const Mesh &mesh)
+{
+  return mesh.triangles.size() * sizeof(MeshTriangle<Mesh>) + mesh.vertices.size() * sizeof(MeshVertex<Mesh>);
+}
 
-  const TriangleMesh mesh{createMesh(writeNumTriangles)};
-  for (auto _ : state) { writeMshPly(mesh, format); }
+// Whether to register a cold page cache variant of every parse benchmark.
+bool registerColdPageCacheBenchmarks = false;
 
-  state.SetBytesProcessed(state.iterations() * meshSizeInBytes(mesh));
+// Whether to register a cold CPU cache variant of every parse and write
+// benchmark, and the size of the buffer written to evict the CPU caches.
+bool registerColdCpuCacheBenchmarks = false;
+std::size_t cpuCacheFlushSize = 0;
+
+// Input sources to register the parse benchmarks for.
+std::vector<InputSource> inputSources{InputSource::File};
+
+// Output sinks to register the write benchmarks for, the directories used by the
+// file backed sinks, and the buffer size used for writing, where zero selects
+// the default buffer size of a stream or `FILE` handle.
+std::vector<OutputSinkType> outputSinks{OutputSinkType::Disk};
+std::filesystem::path tmpfsDirectory{"/dev/shm"};
+std::filesystem::path diskDirectory;
+std::size_t writeBufferSize = 0;
+
+// Helper executable spawned by the time to mesh benchmarks; these benchmarks are
+// only registered in case a helper is set.
+std::filesystem::path loadMeshHelper;
+
+// Malloc configurations to register every parse and write benchmark for; the
+// default configuration is always registered first.
+std::vector<MallocConfig> mallocConfigs{MallocConfig{}};
+
+// Whether to report heap and resident memory usage for every benchmark.
+bool memoryStatsEnabled = false;
+
+// Whether to report hardware performance counters for every benchmark.
+bool perfCountersEnabled = false;
+
+// Whether to report the I/O calls made by every benchmark.
+bool syscallStatsEnabled = false;
+
+// Whether to report percentiles of the time per iteration, and whether to report
+// a histogram of the time per iteration as well.
+bool latencyEnabled = false;
+bool latencyHistogramEnabled = false;
+
+// Whether to report the time spent in every phase of parsing, and the name of
+// the file to write a trace of the phases to, if any.
+bool phaseTimingEnabled = false;
+std::string traceFilename;
+
+// Phases of the first iteration of every parse benchmark, stored by benchmark
+// name, to be written to a trace file once all benchmarks ran.
+std::vector<std::pair<std::string, std::vector<PhaseRecorder::Event>>> traces;
+
+// Registers a single benchmark case. All cases are collected first, so that in
+// interleaved mode they can be registered once per repetition in a random
+// order, and so that in isolated mode a child process can register a single
+// case.
+using Registration = std::function<benchmark::internal::Benchmark *()>;
+std::vector<Registration> registrations;
+
+// Number of interleaved repetitions of every benchmark case, where zero runs
+// all repetitions of a case consecutively.
+std::int64_t interleavedRepetitions = 0;
+
+// Whether every benchmark case runs in its own child process, and the index of
+// the case that is being registered by the parent process in that case.
+bool isolationEnabled = false;
+std::optional<std::size_t> isolatedCase;
+
+// Runs the benchmark case with the given index in a child process, and returns
+// the runs reported by the child process, or std::nullopt in case the child
+// process failed. The child first runs a single iteration of the case, to
+// determine the latency of the first iteration in a fresh process, after which
+// it runs the case as usual.
+std::optional<std::vector<benchmark::BenchmarkReporter::Run>> runInChildProcess(std::size_t index)
+{
+  int fds[2];
+  if (pipe(fds) == -1) { return std::nullopt; }
+
+  // Output buffered by the parent process would otherwise be written twice.
+  std::cout.flush();
+  std::fflush(nullptr);
+
+  const pid_t pid = fork();
+  if (pid == -1)
+  {
+    close(fds[0]);
+    close(fds[1]);
+    return std::nullopt;
+  }
+
+  if (pid == 0)
+  {
+    close(fds[0]);
+    benchmark::ClearRegisteredBenchmarks();
+
+    CollectingReporter firstIteration;
+    registrations[index]()->Iterations(1)->Repetitions(1);
+    benchmark::RunSpecifiedBenchmarks(&firstIteration, "all");
+    benchmark::ClearRegisteredBenchmarks();
+
+    PipeReporter reporter{fds[1]};
+    if (!firstIteration.runs().empty() && !firstIteration.runs().front().error_occurred)
+    {
+      const benchmark::BenchmarkReporter::Run &run = firstIteration.runs().front();
+      reporter.addCounters({{"first_iteration_real_time", run.real_accumulated_time},
+                            {"first_iteration_cpu_time", run.cpu_accumulated_time}});
+    }
+
+    benchmark::internal::Benchmark *b = registrations[index]();
+    if (interleavedRepetitions > 0) { b->Repetitions(1); }
+    benchmark::RunSpecifiedBenchmarks(&reporter, "all");
+
+    std::cout.flush();
+    std::fflush(nullptr);
+    _exit(0);
+  }
+
+  close(fds[1]);
+  std::optional<std::vector<benchmark::BenchmarkReporter::Run>> runs = readRuns(fds[0]);
+  close(fds[0]);
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) == -1 && errno == EINTR) {}
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) { return std::nullopt; }
+
+  return runs;
 }
 
-static void BM_ParseNanoPly(benchmark::State &state, const std::string &filename)
+// Benchmark that acts as a proxy for the benchmark case with the given index,
+// running the case in a child process.
+void BM_Isolated(benchmark::State &state, std::size_t index)
 {
-  benchmark::ClobberMemory();
+  if (state.thread_index() == 0)
+  {
+    std::optional<std::vector<benchmark::BenchmarkReporter::Run>> runs = runInChildProcess(index);
+    if (runs && !runs->empty()) { IsolatedReporter::setChildRuns(std::move(*runs)); }
+    else
+    {
+      IsolatedReporter::setChildRuns({});
+      state.SkipWithError("could not run the benchmark in a child process");
+    }
+  }
 
-  std::optional<TriangleMesh> maybeMesh;
-  for (auto _ : state)
+  for (auto _ : state) {}
+}
+
+// Registers a benchmark case. In case the parent process in isolated mode
+// registers a case, a proxy is registered instead, which runs the case in a
+// child process.
+benchmark::internal::Benchmark *registerBenchmark(
+    const std::string &name, std::function<void(benchmark::State &)> function)
+{
+  if (isolatedCase)
   {
-    if (!(maybeMesh = parseNanoPly(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with nanoply").data());
+    return benchmark::RegisterBenchmark(
+        name.c_str(), [index = *isolatedCase](benchmark::State &state) { BM_Isolated(state, index); });
   }
+  return benchmark::RegisterBenchmark(name.c_str(), std::move(function));
+}
+
+// Registers all benchmark cases in the order they were added. In case
+// interleaved repetitions are enabled, all cases are registered once per
+// repetition instead, running a single repetition each, where the order of the
+// cases is shuffled for every repetition using the given seed. This way, drift
+// in for example CPU frequency or page cache state does not consistently
+// favour the cases that happen to run first. In isolated mode, proxies run a
+// single iteration and repetition, running the case in a child process.
+void registerBenchmarks(std::uint64_t seed)
+{
+  auto registerCase = [](std::size_t index) {
+    if (isolationEnabled) { isolatedCase = index; }
+    benchmark::internal::Benchmark *b = registrations[index]();
+    if (isolationEnabled) { b->Iterations(1)->Repetitions(1); }
+    else if (interleavedRepetitions > 0) { b->Repetitions(1); }
+  };
+
+  std::vector<std::size_t> order(registrations.size());
+  std::iota(order.begin(), order.end(), 0);
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  if (interleavedRepetitions == 0)
+  {
+    for (std::size_t index : order) { registerCase(index); }
+  }
+  else
+  {
+    std::mt19937_64 generator{seed};
+    for (std::int64_t repetition = 0; repetition < interleavedRepetitions; ++repetition)
+    {
+      std::shuffle(order.begin(), order.end(), generator);
+      for (std::size_t index : order) { registerCase(index); }
+    }
+  }
+
+  isolatedCase.reset();
 }
 
-static void BM_WriteNanoPly(benchmark::State &state, Format format)
+std::string escapeJson(const std::string &s)
 {
-  benchmark::ClobberMemory();
+  std::string result;
+  for (char c : s)
+  {
+    if (c == '"' || c == '\\') { result += '\\'; }
+    result += c;
+  }
+  return result;
+}
 
-  const TriangleMesh mesh{createMesh(writeNumTriangles)};
-  for (auto _ : state) { writeNanoPly(mesh, format); }
+// Adds the given phases of a benchmark to the trace, unless the trace already
+// contains phases for that benchmark.
+void addTrace(const std::string &name, const std::vector<PhaseRecorder::Event> &events)
+{
+  auto hasName = [&name](const auto &trace) { return trace.first == name; };
+  if (events.empty() || std::any_of(traces.begin(), traces.end(), hasName)) { return; }
 
-  state.SetBytesProcessed(state.iterations() * meshSizeInBytes(mesh));
+  traces.emplace_back(name, events);
 }
 
-static void BM_ParsePlywoot(benchmark::State &state, const std::string &filename)
+// Writes all traces in the Chrome trace event format, which can be inspected
+// using chrome://tracing or Perfetto. Every benchmark is shown as a thread of
+// its own. Returns false in case the file could not be written.
+bool writeTrace(const std::string &filename)
 {
-  benchmark::ClobberMemory();
+  std::ofstream ofs{filename};
 
-  std::optional<TriangleMesh> maybeMesh;
-  for (auto _ : state)
+  const PhaseRecorder::Clock::time_point origin =
+      traces.empty() ? PhaseRecorder::Clock::time_point{} : traces.front().second.front().start;
+  auto microseconds = [](PhaseRecorder::Clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+  };
+
+  ofs << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (std::size_t tid = 0; tid < traces.size(); ++tid)
   {
-    if (!(maybeMesh = parsePlywoot(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with PLYwoot").data());
+    const auto &[name, events] = traces[tid];
+    ofs << (tid > 0 ? ",\n" : "\n") << R"({"name": "thread_name", "ph": "M", "pid": 1, "tid": )" << tid
+        << R"(, "args": {"name": ")" << escapeJson(name) << "\"}}";
+    for (const PhaseRecorder::Event &event : events)
+    {
+      ofs << ",\n{\"name\": \"" << phaseToString(event.phase) << R"(", "cat": "parse", "ph": "X", "pid": 1)"
+          << ", \"tid\": " << tid << ", \"ts\": " << microseconds(event.start - origin)
+          << ", \"dur\": " << microseconds(event.end - event.start) << '}';
+    }
   }
+  ofs << "\n]}\n";
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  return bool(ofs);
 }
 
-static void BM_WritePlywoot(benchmark::State &state, Format format)
+// Runs the given function once more, outside of the timed benchmark loop, and
+// returns its heap allocations and peak memory usage.
+template<typename Fn>
+MemoryStats measureMemoryStats(Fn fn)
 {
-  benchmark::ClobberMemory();
+  beginMemoryStats();
+  benchmark::DoNotOptimize(fn());
+  return endMemoryStats();
+}
 
-  const TriangleMesh mesh{createMesh(writeNumTriangles)};
-  for (auto _ : state) { writePlywoot(mesh, format); }
+// Reports the given memory statistics as benchmark counters. Peak memory usage
+// is also reported relative to the size of the PLY file that was read or written.
+void setMemoryCounters(benchmark::State &state, const MemoryStats &stats, std::uintmax_t fileSize)
+{
+  using benchmark::Counter;
+  state.counters["allocs"] = Counter(stats.allocations);
+  state.counters["alloc_bytes"] = Counter(stats.allocatedBytes, Counter::kDefaults, Counter::kIs1024);
+  state.counters["peak_heap"] = Counter(stats.peakLiveBytes, Counter::kDefaults, Counter::kIs1024);
+  if (stats.peakRssDelta)
+  {
+    state.counters["peak_rss_delta"] = Counter(*stats.peakRssDelta, Counter::kDefaults, Counter::kIs1024);
+  }
+  if (fileSize > 0) { state.counters["peak_heap_per_file_byte"] = double(stats.peakLiveBytes) / fileSize; }
+}
 
-  state.SetBytesProcessed(state.iterations() * meshSizeInBytes(mesh));
+// Runs the given function once more, outside of the timed benchmark loop, and
+// returns the I/O calls it made.
+template<typename Fn>
+SyscallStats measureSyscallStats(Fn fn)
+{
+  beginSyscallStats();
+  benchmark::DoNotOptimize(fn());
+  return endSyscallStats();
+}
+
+// Returns a short human readable representation of a power of two number of
+// bytes, for example `4KiB`.
+std::string formatPowerOfTwoSize(int exponent)
+{
+  const char *units[] = {"B", "KiB", "MiB", "GiB"};
+  return std::to_string(std::uint64_t{1} << (exponent % 10)) + units[exponent / 10];
 }
 
-static void BM_ParsePlyLib(benchmark::State &state, const std::string &filename)
+// Reports the given I/O call statistics as benchmark counters; per type of call,
+// the number of calls, the number of bytes transferred, the time spent in the
+// calls, and a histogram of the number of bytes per call. Bucket counters like
+// `read_le_4KiB` count the calls that transferred more than half of, and at most
+// the given number of bytes.
+void setSyscallCounters(benchmark::State &state, const SyscallStats &stats)
 {
+  using benchmark::Counter;
+  for (int i = 0; i < numIoCalls; ++i)
+  {
+    const IoCallStats &call = stats.calls[i];
+    if (call.calls == 0) { continue; }
+
+    const IoCall type = IoCall(i);
+    const std::string name = ioCallToString(type);
+    state.counters[name + "_calls"] = Counter(call.calls);
+    state.counters[name + "_time"] = call.seconds;
+    if (type == IoCall::Lseek) { continue; }
+
+    state.counters[name + "_bytes"] = Counter(call.bytes, Counter::kDefaults, Counter::kIs1024);
+    for (int bucket = 0; bucket < numSizeBuckets; ++bucket)
+    {
+      if (call.sizes[bucket] == 0) { continue; }
+      const std::string bucketName = bucket == numSizeBuckets - 1 ? "_gt_" + formatPowerOfTwoSize(bucket - 1)
+                                                                  : "_le_" + formatPowerOfTwoSize(bucket);
+      state.counters[name + bucketName] = Counter(call.sizes[bucket]);
+    }
+  }
+
+  if (stats.readSyscalls) { state.counters["read_syscalls"] = Counter(*stats.readSyscalls); }
+  if (stats.writeSyscalls) { state.counters["write_syscalls"] = Counter(*stats.writeSyscalls); }
+}
+
+// Returns a short human readable representation of a duration that is a power
+// of ten times one, two or five nanoseconds, for example `20us`.
+std::string formatDuration(std::uint64_t ns)
+{
+  const std::pair<std::uint64_t, const char *> units[] = {
+      {1'000'000'000, "s"}, {1'000'000, "ms"}, {1'000, "us"}};
+  for (const auto &[scale, unit] : units)
+  {
+    if (ns >= scale) { return std::to_string(ns / scale) + unit; }
+  }
+  return std::to_string(ns) + "ns";
+}
+
+// Reports the 50th, 90th and 99th percentile, and the maximum of the time per
+// iteration in seconds, and optionally a histogram of the time per iteration.
+// Bucket counters like `latency_le_20us` count the iterations that took more
+// than the upper bound of the previous bucket, and at most the given time.
+void setLatencyCounters(benchmark::State &state, LatencyRecorder &recorder)
+{
+  if (recorder.empty()) { return; }
+
+  state.counters["p50_time"] = recorder.percentile(50);
+  state.counters["p90_time"] = recorder.percentile(90);
+  state.counters["p99_time"] = recorder.percentile(99);
+  state.counters["max_time"] = recorder.percentile(100);
+
+  if (!latencyHistogramEnabled) { return; }
+
+  for (const LatencyRecorder::Bucket &bucket : recorder.histogram())
+  {
+    const std::uint64_t bound = bucket.upperBound > 0 ? bucket.upperBound : LatencyRecorder::maxUpperBound;
+    const std::string name = (bucket.upperBound > 0 ? "latency_le_" : "latency_gt_") + formatDuration(bound);
+    state.counters[name] = benchmark::Counter(bucket.count);
+  }
+}
+
+// Reports the given hardware performance counter values, collected over all
+// iterations of a benchmark, as benchmark counters, normalized per byte of input
+// data and per triangle.
+void setPerfCounters(
+    benchmark::State &state,
+    const PerfCounters::Values &values,
+    std::size_t numBytes,
+    std::size_t numTriangles)
+{
+  for (int event = 0; event < PerfCounters::NumEvents; ++event)
+  {
+    if (!values[event]) { continue; }
+
+    const double perIteration = *values[event] / state.iterations();
+    const std::string name = PerfCounters::eventName(PerfCounters::Event(event));
+    if (numBytes > 0) { state.counters[name + "_per_byte"] = perIteration / numBytes; }
+    if (numTriangles > 0) { state.counters[name + "_per_triangle"] = perIteration / numTriangles; }
+  }
+}
+
+// Reports the throughput of a benchmark in terms of bytes of the PLY file, and
+// in terms of vertices and triangles of the mesh.
+void setThroughputCounters(
+    benchmark::State &state,
+    std::uintmax_t fileSize,
+    std::int64_t numVertices,
+    std::int64_t numTriangles)
+{
+  using benchmark::Counter;
+  const double iterations = state.iterations();
+  state.counters["file_bytes_per_second"] =
+      Counter(iterations * fileSize, Counter::kIsRate, Counter::kIs1024);
+  state.counters["vertices_per_second"] = Counter(iterations * numVertices, Counter::kIsRate);
+  state.counters["triangles_per_second"] = Counter(iterations * numTriangles, Counter::kIsRate);
+}
+
+// Reads the given file into the given buffer, which should be as large as the
+// file, using plain `read()` calls. Returns false in case of an error.
+bool readIntoBuffer(const std::string &filename, std::vector<char> &buffer)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) { return false; }
+
+  std::size_t offset = 0;
+  while (offset < buffer.size())
+  {
+    const ssize_t n = read(fd, buffer.data() + offset, buffer.size() - offset);
+    if (n <= 0) { break; }
+    offset += n;
+  }
+
+  close(fd);
+  return offset == buffer.size();
+}
+
+// Maps the given file into memory, and touches every page of the file. Returns
+// the sum of the first byte of every page, or an empty optional in case of an
+// error.
+std::optional<std::uint64_t> mapAndTouch(const std::string &filename)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) { return std::nullopt; }
+
+  const off_t size = lseek(fd, 0, SEEK_END);
+  void *addr = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+  close(fd);
+  if (addr == MAP_FAILED) { return std::nullopt; }
+
+  const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+  const volatile unsigned char *data = static_cast<const unsigned char *>(addr);
+  std::uint64_t sum = 0;
+  for (off_t offset = 0; offset < size; offset += pageSize) { sum += data[offset]; }
+
+  munmap(addr, size);
+  return sum;
+}
+
+// Returns a mesh of the given size, filled by copying as much data as available
+// from the given buffer; this is the least amount of work a parser needs to do
+// to produce a mesh from data in memory.
+template<typename Mesh>
+Mesh copyIntoMesh(const char *data, std::size_t size, std::int64_t numVertices, std::int64_t numTriangles)
+{
+  Mesh mesh;
+  mesh.vertices.resize(numVertices);
+  mesh.triangles.resize(numTriangles);
+
+  std::size_t vertexBytes = 0;
+  if constexpr (std::is_same_v<Mesh, SoaTriangleMesh>)
+  {
+    for (std::vector<float> *coordinates : {&mesh.vertices.x, &mesh.vertices.y, &mesh.vertices.z})
+    {
+      const std::size_t bytes = std::min(size - vertexBytes, coordinates->size() * sizeof(float));
+      std::memcpy(coordinates->data(), data + vertexBytes, bytes);
+      vertexBytes += bytes;
+    }
+  }
+  else
+  {
+    vertexBytes = std::min(size, mesh.vertices.size() * sizeof(MeshVertex<Mesh>));
+    std::memcpy(mesh.vertices.data(), data, vertexBytes);
+  }
+  const std::size_t triangleBytes =
+      std::min(size - vertexBytes, mesh.triangles.size() * sizeof(MeshTriangle<Mesh>));
+  std::memcpy(mesh.triangles.data(), data + vertexBytes, triangleBytes);
+
+  return mesh;
+}
+
+// Time in seconds it takes to read a model into memory using `read()`, and the
+// time it takes to copy the data into a triangle mesh; together, these form the
+// roofline of a parser.
+struct RooflineTime
+{
+  double read{0};
+  double copy{0};
+};
+
+// Returns the roofline time for the given model when parsed into a mesh of the
+// given type. The fastest out of three runs is taken, and cached for subsequent
+// calls.
+template<typename Mesh>
+RooflineTime rooflineTime(const std::string &filename, const PlyHeader &header)
+{
+  static std::mutex mutex;
+  static std::map<std::string, RooflineTime> cache;
+
+  std::lock_guard<std::mutex> lock{mutex};
+
+  auto it = cache.find(filename);
+  if (it == cache.end())
+  {
+    std::vector<char> buffer(std::filesystem::file_size(filename));
+
+    using Seconds = std::chrono::duration<double>;
+    Seconds fastestRead{std::numeric_limits<double>::max()};
+    Seconds fastestCopy{std::numeric_limits<double>::max()};
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      readIntoBuffer(filename, buffer);
+      const auto read = std::chrono::steady_clock::now();
+      benchmark::DoNotOptimize(
+          copyIntoMesh<Mesh>(buffer.data(), buffer.size(), header.numVertices, header.numFaces));
+      const auto end = std::chrono::steady_clock::now();
+
+      fastestRead = std::min<Seconds>(fastestRead, read - start);
+      fastestCopy = std::min<Seconds>(fastestCopy, end - read);
+    }
+    it = cache.emplace(filename, RooflineTime{fastestRead.count(), fastestCopy.count()}).first;
+  }
+
+  return it->second;
+}
+
+// Returns the time in seconds it takes to parse the given model using the given
+// parse function, without any other threads running. The fastest out of three
+// runs is taken, and cached for subsequent calls.
+double singleThreadedParseTime(ParseFunction parse, const std::string &filename)
+{
+  static std::mutex mutex;
+  static std::map<std::pair<ParseFunction, std::string>, double> cache;
+
+  std::lock_guard<std::mutex> lock{mutex};
+
+  auto it = cache.find({parse, filename});
+  if (it == cache.end())
+  {
+    std::chrono::duration<double> fastest{std::numeric_limits<double>::max()};
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      benchmark::DoNotOptimize(parse(filename));
+      fastest = std::min<std::chrono::duration<double>>(fastest, std::chrono::steady_clock::now() - start);
+    }
+    it = cache.emplace(std::make_pair(parse, filename), fastest.count()).first;
+  }
+
+  return it->second;
+}
+}
+
+// Options that select the variant of a parse benchmark.
+struct ParseOptions
+{
+  // Evicts the model from the page cache before every iteration.
+  bool coldPageCache{false};
+
+  // Evicts all data from the CPU caches before every iteration.
+  bool coldCpuCache{false};
+
+  // Source of the model data; for `InputSource::Memory`, the model is read into
+  // memory before the benchmark loop, so that only decoding is measured.
+  InputSource inputSource{InputSource::File};
+
+  // Name of the benchmark, used for the trace of the phases of parsing.
+  std::string name;
+
+  // Malloc parameters applied while running the benchmark.
+  MallocConfig mallocConfig;
+
+  // Parses a triangle mesh using the parse function of the library that
+  // converts from the types stored in the model, see `ParserBackend::parseAs`.
+  bool convertTypes{false};
+
+  // Mesh stored in a huge model, which the parsed mesh is checked against by
+  // streaming it. The roofline is not reported for huge models, since it holds
+  // both the model and a mesh in memory.
+  std::optional<MeshStream> generatedMesh{};
+};
+
+// Parses a model into a mesh of the given type; attributed meshes, meshes that
+// store their vertices as a structure of arrays, and triangle meshes with other
+// types than `TriangleMesh` are only parsed from file.
+template<typename Mesh>
+static void BM_Parse(
+    benchmark::State &state,
+    const ParserBackend &backend,
+    const std::string &filename,
+    const ParseOptions &options)
+{
+  const MallocConfigScope mallocConfigScope{options.mallocConfig};
+  if (!mallocConfigScope.applied())
+  {
+    state.SkipWithError(("glibc rejected malloc configuration " + options.mallocConfig.name()).data());
+    return;
+  }
   benchmark::ClobberMemory();
 
-  std::optional<TriangleMesh> maybeMesh;
+  std::optional<ParserInput> memoryInput;
+  if (options.inputSource == InputSource::Memory) { memoryInput.emplace(InputSource::Memory, filename); }
+
+  auto parseModel = [&]() -> std::optional<Mesh> {
+    if constexpr (std::is_same_v<Mesh, AttributedTriangleMesh>) { return backend.parseAttributed(filename); }
+    else if constexpr (std::is_same_v<Mesh, SoaTriangleMesh>) { return backend.parseSoa(filename); }
+    else if constexpr (!std::is_same_v<Mesh, TriangleMesh>)
+    {
+      return std::get<MeshParseFunction<Mesh>>(backend.parseAs)(filename);
+    }
+    else
+    {
+      if (options.convertTypes) { return std::get<MeshParseFunction<Mesh>>(backend.parseAs)(filename); }
+
+      switch (options.inputSource)
+      {
+        case InputSource::File:
+          return backend.parse(filename);
+        case InputSource::Memory:
+          return memoryInput->valid() ? backend.parseInput(*memoryInput) : std::nullopt;
+        case InputSource::MemoryMap:
+        {
+          startPhase(Phase::Open);
+          const ParserInput input{InputSource::MemoryMap, filename};
+          return input.valid() ? backend.parseInput(input) : std::nullopt;
+        }
+      }
+      return std::nullopt;
+    }
+  };
+
+  std::optional<PerfCounters> perfCounters;
+  if (perfCountersEnabled) { perfCounters.emplace().start(); }
+
+  // Only the phases of the first iteration are recorded for the trace.
+  std::optional<PhaseRecorder> phaseRecorder;
+  if (phaseTimingEnabled) { phaseRecorder.emplace().recordEvents(!traceFilename.empty()); }
+
+  std::optional<LatencyRecorder> latencyRecorder;
+  if (latencyEnabled) { latencyRecorder.emplace(state.max_iterations); }
+
+  std::optional<Mesh> maybeMesh;
+  double residency = 0;
+  std::chrono::duration<double> parseTime{0};
   for (auto _ : state)
   {
-    if (!(maybeMesh = parsePlyLib(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with plylib").data());
+    if (options.coldPageCache || options.coldCpuCache)
+    {
+      state.PauseTiming();
+      if (perfCounters) { perfCounters->pause(); }
+      if (options.coldPageCache)
+      {
+        if (!evictFromPageCache(filename))
+          state.SkipWithError((std::string{"could not evict '"} + filename + "' from the page cache").data());
+        residency += pageCacheResidency(filename);
+      }
+      if (options.coldCpuCache) { flushCpuCaches(cpuCacheFlushSize); }
+      if (perfCounters) { perfCounters->resume(); }
+      state.ResumeTiming();
+    }
+
+    if (latencyRecorder) { latencyRecorder->start(); }
+    const auto parseStart = std::chrono::steady_clock::now();
+    // Releases the mesh of the previous iteration first, so that no two meshes
+    // reside in memory at once.
+    maybeMesh.reset();
+    if (!(maybeMesh = parseModel()))
+    {
+      state.SkipWithError(
+          (std::string{"could not parse '"} + filename + "' with " + backend.libraryName).data());
+    }
+    benchmark::DoNotOptimize(maybeMesh);
+    parseTime += std::chrono::steady_clock::now() - parseStart;
+    if (latencyRecorder) { latencyRecorder->stop(); }
+    if (phaseRecorder) { phaseRecorder->recordEvents(false); }
+  }
+
+  if (phaseRecorder)
+  {
+    phaseRecorder->stop();
+    for (int phase = 0; phase < numPhases; ++phase)
+    {
+      state.counters[std::string{phaseToString(Phase(phase))} + "_time"] =
+          benchmark::Counter(phaseRecorder->totals()[phase], benchmark::Counter::kAvgIterations);
+    }
+    if (!traceFilename.empty()) { addTrace(options.name, phaseRecorder->events()); }
+    phaseRecorder.reset();
+  }
+
+  if constexpr (std::is_same_v<Mesh, Int64TriangleMesh>)
+  {
+    if (maybeMesh && options.generatedMesh && !matchesGeneratedMesh(*maybeMesh, *options.generatedMesh))
+    {
+      state.SkipWithError(
+          (std::string{"'"} + filename + "' was parsed incorrectly by " + backend.libraryName).data());
+    }
+  }
+
+  const std::uintmax_t fileSize = std::filesystem::file_size(filename);
+  if (maybeMesh)
+  {
+    state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+    setThroughputCounters(state, fileSize, maybeMesh->vertices.size(), maybeMesh->triangles.size());
+  }
+
+  if (perfCounters && maybeMesh)
+  {
+    setPerfCounters(state, perfCounters->stop(), fileSize, maybeMesh->triangles.size());
+  }
+
+  if (latencyRecorder && maybeMesh) { setLatencyCounters(state, *latencyRecorder); }
+
+  // Relates the time spent parsing to the roofline time of the model, which
+  // excludes reading the file for the memory input source. Since the roofline
+  // assumes warm caches, this is not reported for cold page cache and cold CPU
+  // cache benchmarks.
+  const std::optional<PlyHeader> header = readPlyHeader(filename);
+  if (maybeMesh && header && !options.coldPageCache && !options.coldCpuCache && !options.generatedMesh)
+  {
+    const RooflineTime roofline = rooflineTime<Mesh>(filename, *header);
+    const double rooflineSeconds =
+        roofline.copy + (options.inputSource == InputSource::Memory ? 0 : roofline.read);
+    state.counters["percent_of_roofline"] = 100 * rooflineSeconds * state.iterations() / parseTime.count();
+  }
+
+  // Reports which fraction of the model still resided in the page cache right
+  // before parsing, which should be close to zero unless eviction is not
+  // supported by the file system the model is stored on (tmpfs, for example).
+  if (options.coldPageCache) state.counters["page_cache_residency"] = residency / state.iterations();
+
+  if (maybeMesh && memoryStatsEnabled)
+  {
+    maybeMesh.reset();
+    const MemoryStats stats = measureMemoryStats(parseModel);
+    setMemoryCounters(state, stats, fileSize);
   }
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  if (maybeMesh && syscallStatsEnabled)
+  {
+    maybeMesh.reset();
+    setSyscallCounters(state, measureSyscallStats(parseModel));
+  }
 }
 
-static void BM_ParseRPly(benchmark::State &state, const std::string &filename)
+// Parses a model into a triangle mesh of the given precision, converting from
+// the types stored in the model.
+static void BM_ParseAs(
+    benchmark::State &state,
+    const ParserBackend &backend,
+    const std::string &filename,
+    const ParseOptions &options,
+    MeshPrecision precision)
+{
+  const std::optional<PlyHeader> header = readPlyHeader(filename);
+  if (header && std::size_t(header->numVertices) > maxMeshVertices(precision))
+  {
+    state.SkipWithError(("too many vertices for " + meshPrecisionToString(precision)).data());
+    return;
+  }
+
+  visitMeshPrecision(precision, [&](auto mesh) {
+    BM_Parse<decltype(mesh)>(state, backend, filename, options);
+  });
+}
+
+// Baselines that make up the roofline of a parser for a model.
+enum class Roofline { Read, MemoryMap, Memcpy };
+
+// Measures a baseline for parsing the given model: reading the whole file into
+// a buffer using `read()`, mapping the file into memory and touching all pages,
+// or copying an amount of data equal to the size of the mesh into a newly
+// allocated mesh of the given type.
+template<typename Mesh>
+static void BM_Roofline(benchmark::State &state, Roofline roofline, const std::string &filename)
 {
   benchmark::ClobberMemory();
 
-  std::optional<TriangleMesh> maybeMesh;
+  const std::optional<PlyHeader> header = readPlyHeader(filename);
+  if (!header)
+  {
+    state.SkipWithError((std::string{"could not read the header of '"} + filename + "'").data());
+    return;
+  }
+
+  const std::uintmax_t fileSize = std::filesystem::file_size(filename);
+  const std::size_t meshSize =
+      header->numVertices * sizeof(MeshVertex<Mesh>) + header->numFaces * sizeof(MeshTriangle<Mesh>);
+
+  std::vector<char> buffer(roofline == Roofline::Read ? fileSize : 0);
+
+  // The data to copy is not initialized, since zero-filling it is not part of
+  // the baseline, but every page is touched once so that page faults are not
+  // measured either.
+  std::unique_ptr<char[]> copySource;
+  if (roofline == Roofline::Memcpy)
+  {
+    copySource.reset(new char[meshSize]);
+    const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    for (std::size_t offset = 0; offset < meshSize; offset += pageSize) { copySource[offset] = 0; }
+  }
+
+  for (auto _ : state)
+  {
+    switch (roofline)
+    {
+      case Roofline::Read:
+        if (!readIntoBuffer(filename, buffer))
+          state.SkipWithError((std::string{"could not read '"} + filename + "'").data());
+        break;
+      case Roofline::MemoryMap:
+        if (!mapAndTouch(filename))
+          state.SkipWithError((std::string{"could not map '"} + filename + "'").data());
+        break;
+      case Roofline::Memcpy:
+        benchmark::DoNotOptimize(
+            copyIntoMesh<Mesh>(copySource.get(), meshSize, header->numVertices, header->numFaces));
+        break;
+    }
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * meshSize);
+  setThroughputCounters(state, fileSize, header->numVertices, header->numFaces);
+}
+
+// Measures the wall time from spawning a helper process that parses the given
+// model using the library with the given benchmark name suffix, until the helper
+// reports that the mesh is ready. This includes loading the executable, dynamic
+// initialization, and page faults on a fresh heap. The time until the helper
+// exited is reported separately.
+static void BM_TimeToMesh(
+    benchmark::State &state, const std::string &benchmarkName, const std::string &filename)
+{
+  // The write end of the pipe is duplicated to this file descriptor in the
+  // helper.
+  const int readyFd = 3;
+
+  std::string helper{loadMeshHelper.string()};
+  std::string library{benchmarkName};
+  std::string model{filename};
+  std::string readyFdArg{std::to_string(readyFd)};
+  char *args[] = {helper.data(), library.data(), model.data(), readyFdArg.data(), nullptr};
+
+  std::chrono::duration<double> exitTime{0};
   for (auto _ : state)
   {
-    if (!(maybeMesh = parseRPly(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with RPly").data());
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) == -1)
+    {
+      state.SkipWithError("could not create a pipe");
+      break;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], readyFd);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    pid_t pid;
+    const bool spawned = posix_spawn(&pid, helper.c_str(), &actions, nullptr, args, environ) == 0;
+    close(fds[1]);
+
+    char ready = 0;
+    ssize_t n;
+    while ((n = read(fds[0], &ready, 1)) == -1 && errno == EINTR) {}
+
+    const auto meshReady = std::chrono::steady_clock::now();
+
+    int status = 0;
+    if (spawned)
+    {
+      while (waitpid(pid, &status, 0) == -1 && errno == EINTR) {}
+    }
+    exitTime += std::chrono::steady_clock::now() - start;
+
+    close(fds[0]);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (!spawned || n != 1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      state.SkipWithError(
+          (std::string{"could not parse '"} + filename + "' with " + benchmarkName + " in " + helper).data());
+      break;
+    }
+
+    state.SetIterationTime(std::chrono::duration<double>(meshReady - start).count());
   }
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  state.counters["exit_time"] = benchmark::Counter(exitTime.count(), benchmark::Counter::kAvgIterations);
 }
 
-static void BM_WriteRPly(benchmark::State &state, Format format)
+// Options that select the variant of a write benchmark.
+struct WriteOptions
+{
+  OutputSinkType sink{OutputSinkType::Disk};
+
+  // Directory to write to for the file backed sinks.
+  std::filesystem::path directory;
+
+  // Buffer size of the stream or `FILE` handle; zero selects the default.
+  std::size_t bufferSize{0};
+
+  // Evicts all data from the CPU caches before every iteration.
+  bool coldCpuCache{false};
+
+  // Malloc parameters applied while running the benchmark.
+  MallocConfig mallocConfig;
+};
+
+template<typename Mesh>
+static void BM_Write(
+    benchmark::State &state,
+    const WriterBackend &backend,
+    Format format,
+    const WriteOptions &options)
 {
+  const MallocConfigScope mallocConfigScope{options.mallocConfig};
+  if (!mallocConfigScope.applied())
+  {
+    state.SkipWithError(("glibc rejected malloc configuration " + options.mallocConfig.name()).data());
+    return;
+  }
   benchmark::ClobberMemory();
 
-  const TriangleMesh mesh{createMesh(writeNumTriangles)};
-  for (auto _ : state) { writeRPly(mesh, format); }
+  const Mesh &mesh{writeBenchmarkMesh<Mesh>(state.range(0))};
+  auto writeToSink = [&](OutputSink &sink) {
+    if constexpr (std::is_same_v<Mesh, AttributedTriangleMesh>)
+    {
+      return backend.writeAttributed(mesh, format, sink) && sink.close();
+    }
+    else if constexpr (std::is_same_v<Mesh, SoaTriangleMesh>)
+    {
+      return backend.writeSoa(mesh, format, sink) && sink.close();
+    }
+    else { return backend.write(mesh, format, sink) && sink.close(); }
+  };
+
+  std::optional<LatencyRecorder> latencyRecorder;
+  if (latencyEnabled) { latencyRecorder.emplace(state.max_iterations); }
+
+  std::optional<PerfCounters> perfCounters;
+  if (perfCountersEnabled) { perfCounters.emplace().start(); }
+
+  // Note that creating the sink, and closing and removing a file are part of
+  // the measurements, like they are when writing a file in an application.
+  for (auto _ : state)
+  {
+    if (options.coldCpuCache)
+    {
+      state.PauseTiming();
+      if (perfCounters) { perfCounters->pause(); }
+      flushCpuCaches(cpuCacheFlushSize);
+      if (perfCounters) { perfCounters->resume(); }
+      state.ResumeTiming();
+    }
+
+    if (latencyRecorder) { latencyRecorder->start(); }
+    OutputSink sink{options.sink, options.directory, options.bufferSize};
+    if (!writeToSink(sink))
+    {
+      const std::string error{
+          "could not write to " + outputSinkTypeToString(options.sink) + " sink with " + backend.libraryName};
+      state.SkipWithError(error.data());
+    }
+    if (latencyRecorder) { latencyRecorder->stop(); }
+  }
 
   state.SetBytesProcessed(state.iterations() * meshSizeInBytes(mesh));
+
+  if (perfCounters)
+  {
+    setPerfCounters(state, perfCounters->stop(), meshSizeInBytes(mesh), mesh.triangles.size());
+  }
+
+  if (latencyRecorder) { setLatencyCounters(state, *latencyRecorder); }
+
+  if (memoryStatsEnabled)
+  {
+    OutputSink sink{options.sink, options.directory, options.bufferSize};
+    const MemoryStats stats = measureMemoryStats([&]() { return writeToSink(sink); });
+    setMemoryCounters(state, stats, sink.size());
+  }
+
+  if (syscallStatsEnabled)
+  {
+    OutputSink sink{options.sink, options.directory, options.bufferSize};
+    const SyscallStats stats = measureSyscallStats([&]() { return writeToSink(sink); });
+    setSyscallCounters(state, stats);
+  }
 }
 
-static void BM_ParseTinyply(benchmark::State &state, const std::string &filename)
+// Parses a model from every benchmark thread at the same time; either all threads
+// parse the same model, or every thread parses a model of its own. Next to the
+// aggregate transfer speed, this reports the slowdown of a single parse compared
+// to parsing the same model without any other threads running, which exposes
+// global state shared between threads in a PLY library or in the allocator.
+static void BM_ConcurrentParse(
+    benchmark::State &state,
+    const ParserBackend &backend,
+    const std::vector<std::string> &filenames)
 {
   benchmark::ClobberMemory();
 
+  const std::string &filename = filenames[state.thread_index() % filenames.size()];
+
+  // The first thread determines the single threaded parse time of every model,
+  // while all other threads wait for the benchmark loop to start.
+  if (state.thread_index() == 0)
+  {
+    for (const std::string &modelFilename : filenames)
+    {
+      singleThreadedParseTime(backend.parse, modelFilename);
+    }
+  }
+
   std::optional<TriangleMesh> maybeMesh;
+  std::chrono::duration<double> parseTime{0};
   for (auto _ : state)
   {
-    if (!(maybeMesh = parseTinyply(filename)))
-      state.SkipWithError((std::string{"could not parse '"} + filename + "' with tinyply").data());
+    const auto start = std::chrono::steady_clock::now();
+    if (!(maybeMesh = backend.parse(filename)))
+    {
+      state.SkipWithError(
+          (std::string{"could not parse '"} + filename + "' with " + backend.libraryName).data());
+    }
+    parseTime += std::chrono::steady_clock::now() - start;
   }
 
-  if (maybeMesh) state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+  if (maybeMesh)
+  {
+    state.SetBytesProcessed(state.iterations() * meshSizeInBytes(*maybeMesh));
+
+    const double baseline = singleThreadedParseTime(backend.parse, filename);
+    state.counters["slowdown"] = benchmark::Counter(
+        parseTime.count() / state.iterations() / baseline, benchmark::Counter::kAvgThreads);
+  }
 }
 
-static void BM_WriteTinyply(benchmark::State &state, Format format)
+// Parses a model with faces of any number of vertices into a polygon mesh. In
+// case `triangulateOnLoad` is set, every iteration triangulates the polygon mesh
+// as well, so that the cost of converting to a triangle mesh is included. The
+// number of triangles is reported for both variants, so that their throughput
+// can be compared directly.
+static void BM_ParsePolygons(
+    benchmark::State &state,
+    const ParserBackend &backend,
+    const std::string &filename,
+    bool triangulateOnLoad)
 {
   benchmark::ClobberMemory();
 
-  const TriangleMesh mesh{createMesh(writeNumTriangles)};
-  for (auto _ : state) { writeTinyply(mesh, format); }
+  std::optional<PolygonMesh> maybeMesh;
+  std::optional<TriangleMesh> maybeTriangleMesh;
+  std::size_t numFaces = 0;
+  for (auto _ : state)
+  {
+    if (!(maybeMesh = backend.parsePolygon(filename)))
+    {
+      state.SkipWithError(
+          (std::string{"could not parse '"} + filename + "' with " + backend.libraryName).data());
+      break;
+    }
+    numFaces = maybeMesh->numFaces();
+    if (triangulateOnLoad)
+    {
+      maybeTriangleMesh = triangulate(std::move(*maybeMesh));
+      benchmark::DoNotOptimize(maybeTriangleMesh);
+    }
+    else { benchmark::DoNotOptimize(maybeMesh); }
+  }
 
-  state.SetBytesProcessed(state.iterations() * meshSizeInBytes(mesh));
+  if (!maybeMesh) { return; }
+
+  const std::size_t numVertices =
+      maybeTriangleMesh ? maybeTriangleMesh->vertices.size() : maybeMesh->vertices.size();
+  const std::size_t numTriangles =
+      maybeTriangleMesh ? maybeTriangleMesh->triangles.size() : countTriangles(*maybeMesh);
+  const std::size_t meshSize =
+      maybeTriangleMesh ? meshSizeInBytes(*maybeTriangleMesh)
+                        : (maybeMesh->offsets.size() + maybeMesh->indices.size()) * sizeof(std::int32_t) +
+                              maybeMesh->vertices.size() * sizeof(Vertex);
+
+  state.SetBytesProcessed(state.iterations() * meshSize);
+  setThroughputCounters(state, std::filesystem::file_size(filename), numVertices, numTriangles);
+  state.counters["faces_per_second"] =
+      benchmark::Counter(double(state.iterations()) * numFaces, benchmark::Counter::kIsRate);
 }
 
 #define TIME_UNIT benchmark::kMillisecond
 
-#define BENCHMARK_PARSE(name, filename)                                                                      \
-  BENCHMARK_CAPTURE(BM_ParseHapply, name, (filename))->Unit(TIME_UNIT);                                      \
-  BENCHMARK_CAPTURE(BM_ParseMiniply, name, (filename))->Unit(TIME_UNIT);                                     \
-  BENCHMARK_CAPTURE(BM_ParseMshPly, name, (filename))->Unit(TIME_UNIT);                                      \
-  BENCHMARK_CAPTURE(BM_ParseNanoPly, name, (filename))->Unit(TIME_UNIT);                                     \
-  BENCHMARK_CAPTURE(BM_ParsePlywoot, name, (filename))->Unit(TIME_UNIT);                                     \
-  BENCHMARK_CAPTURE(BM_ParsePlyLib, name, (filename))->Unit(TIME_UNIT);                                      \
-  BENCHMARK_CAPTURE(BM_ParseRPly, name, (filename))->Unit(TIME_UNIT);                                        \
-  BENCHMARK_CAPTURE(BM_ParseTinyply, name, (filename))->Unit(TIME_UNIT);
-
-#define BENCHMARK_PARSE_NO_TINYPLY(name, filename)                                                           \
-  BENCHMARK_CAPTURE(BM_ParseHapply, name, (filename))->Unit(TIME_UNIT);                                      \
-  BENCHMARK_CAPTURE(BM_ParseMiniply, name, (filename))->Unit(TIME_UNIT);                                     \
-  BENCHMARK_CAPTURE(BM_ParseMshPly, name, (filename))->Unit(TIME_UNIT);                                      \
-  BENCHMARK_CAPTURE(BM_ParseNanoPly, name, (filename))->Unit(TIME_UNIT);                                     \
-  BENCHMARK_CAPTURE(BM_ParsePlywoot, name, (filename))->Unit(TIME_UNIT);                                     \
-  BENCHMARK_CAPTURE(BM_ParsePlyLib, name, (filename))->Unit(TIME_UNIT);                                      \
-  BENCHMARK_CAPTURE(BM_ParseRPly, name, (filename))->Unit(TIME_UNIT);
-
-BENCHMARK_PARSE("Asian Dragon (binary big endian)", "models/xyzrgb_dragon.ply")
-BENCHMARK_PARSE("Lucy (binary big endian)", "models/lucy.ply");
-
-BENCHMARK_PARSE("DOOM Combat Scene (binary little endian)", "models/Doom combat scene.ply");
-BENCHMARK_PARSE("PBRT-v3 Dragon (binary little endian)", "models/dragon_remeshed.ply");
-
-// Note; tinyply 2.3 seems to be broken for ASCII
-// (https://github.com/ddiakopoulos/tinyply/issues/59)
-BENCHMARK_PARSE_NO_TINYPLY("Dragon (ASCII)", "models/dragon_vrip.ply");
-BENCHMARK_PARSE_NO_TINYPLY("Happy Buddha (ASCII)", "models/happy_vrip.ply");
-BENCHMARK_PARSE_NO_TINYPLY("Stanford Bunny (ASCII)", "models/bun_zipper.ply");
-
-#define BENCHMARK_WRITE(benchmarkName)                                                                       \
-  BENCHMARK_CAPTURE(benchmarkName, "ASCII", Format::Ascii)->Unit(TIME_UNIT);                                 \
-  BENCHMARK_CAPTURE(benchmarkName, "binary", Format::BinaryLittleEndian)->Unit(TIME_UNIT);
-
-BENCHMARK_WRITE(BM_WriteHapply);
-BENCHMARK_WRITE(BM_WriteMshPly);
-BENCHMARK_WRITE(BM_WriteNanoPly);
-BENCHMARK_WRITE(BM_WritePlywoot);
-BENCHMARK_WRITE(BM_WriteRPly);
-BENCHMARK_WRITE(BM_WriteTinyply);
-
-BENCHMARK_MAIN();
+// Registers roofline benchmarks and parse benchmarks for all PLY libraries for
+// the given model. In case a `prepare` function is given, it is called before
+// running a benchmark to make sure the model is available. Otherwise, the
+// benchmarks are only registered in case the model is available locally. A parse
+// benchmark is registered for every enabled input source the library supports.
+// In case cold page cache benchmarks are enabled, a cold page cache variant is
+// registered next to every benchmark that does not read from memory. In case
+// time to mesh benchmarks are enabled, one is registered for every library.
+// Models are parsed into meshes of the given type; attributed meshes and meshes
+// that store their vertices as a structure of arrays are only parsed from file,
+// and have no time to mesh benchmarks. The latter are parsed from the same
+// models as triangle meshes, hence their names get a `SoA` suffix, and their
+// rooflines are not registered again.
+template<typename Mesh = TriangleMesh>
+static void registerParseBenchmarks(
+    const std::string &name,
+    const std::string &filename,
+    Format format,
+    std::function<bool()> prepare = {})
+{
+  if (!prepare && !std::filesystem::exists(filename)) { return; }
+
+  // Generated models are not available yet, but are known to be supported by
+  // all libraries.
+  const std::optional<PlyHeader> header = prepare ? std::nullopt : readPlyHeader(filename);
+
+  const bool soa = std::is_same_v<Mesh, SoaTriangleMesh>;
+  for (const auto &[roofline, benchmarkName] :
+       {std::make_pair(Roofline::Read, "Read"), std::make_pair(Roofline::MemoryMap, "Mmap"),
+        std::make_pair(Roofline::Memcpy, "Memcpy")})
+  {
+    if (soa) { break; }
+
+    registrations.push_back([roofline = roofline, benchmarkName = benchmarkName, name, filename, prepare]() {
+      return registerBenchmark(
+                 std::string{"BM_Roofline"} + benchmarkName + '/' + name,
+                 [roofline, filename, prepare](benchmark::State &state) {
+                   if (prepare && !prepare())
+                   {
+                     state.SkipWithError((std::string{"could not generate '"} + filename + "'").data());
+                     return;
+                   }
+                   BM_Roofline<Mesh>(state, roofline, filename);
+                 })
+          ->Unit(TIME_UNIT);
+    });
+  }
+
+  for (const ParserBackend &backend : parserBackends())
+  {
+    if (!backend.supports(format, header)) { continue; }
+    if (soa && !backend.parseSoa) { continue; }
+
+    for (const MallocConfig &mallocConfig : mallocConfigs)
+    {
+      for (InputSource inputSource : inputSources)
+      {
+        if (!backend.supports(inputSource)) { continue; }
+        if (!std::is_same_v<Mesh, TriangleMesh> && inputSource != InputSource::File) { continue; }
+
+        for (const auto &[coldPageCache, coldCpuCache] :
+             {std::make_pair(false, false), std::make_pair(true, false), std::make_pair(false, true)})
+        {
+          if (coldPageCache && (!registerColdPageCacheBenchmarks || inputSource == InputSource::Memory))
+          {
+            continue;
+          }
+          if (coldCpuCache && !registerColdCpuCacheBenchmarks) { continue; }
+
+          const std::string variant{
+              (soa ? "/SoA" : "") +
+              (inputSource != InputSource::File ? '/' + inputSourceToString(inputSource) : "") +
+              (coldPageCache ? "/cold page cache" : "") + (coldCpuCache ? "/cold CPU cache" : "") +
+              (mallocConfig.isDefault() ? "" : "/malloc:" + mallocConfig.name())};
+
+          // Cold page cache benchmarks spend time waiting for I/O, which is not
+          // accounted for in CPU time, hence real time is measured instead.
+          const std::string benchmarkFullName{"BM_Parse" + backend.benchmarkName + '/' + name + variant};
+          const ParseOptions options{
+              coldPageCache, coldCpuCache, inputSource, benchmarkFullName, mallocConfig};
+          registrations.push_back([&backend, filename, options, prepare]() {
+            benchmark::internal::Benchmark *b = registerBenchmark(
+                options.name,
+                [&backend, filename, options, prepare](benchmark::State &state) {
+                  if (prepare && !prepare())
+                  {
+                    state.SkipWithError((std::string{"could not generate '"} + filename + "'").data());
+                    return;
+                  }
+                  BM_Parse<Mesh>(state, backend, filename, options);
+                });
+            b->Unit(TIME_UNIT);
+            if (options.coldPageCache) { b->UseRealTime(); }
+            return b;
+          });
+        }
+      }
+    }
+
+    if (!loadMeshHelper.empty() && std::is_same_v<Mesh, TriangleMesh>)
+    {
+      registrations.push_back([benchmarkName = backend.benchmarkName, name, filename, prepare]() {
+        return registerBenchmark(
+                   "BM_TimeToMesh" + benchmarkName + '/' + name,
+                   [benchmarkName, filename, prepare](benchmark::State &state) {
+                     if (prepare && !prepare())
+                     {
+                       state.SkipWithError((std::string{"could not generate '"} + filename + "'").data());
+                       return;
+                     }
+                     BM_TimeToMesh(state, benchmarkName, filename);
+                   })
+            ->UseManualTime()
+            ->Unit(TIME_UNIT);
+      });
+    }
+  }
+}
+
+static void registerModelParseBenchmarks()
+{
+  registerParseBenchmarks(
+      "Asian Dragon (binary big endian)", "models/xyzrgb_dragon.ply", Format::BinaryBigEndian);
+  registerParseBenchmarks("Lucy (binary big endian)", "models/lucy.ply", Format::BinaryBigEndian);
+
+  registerParseBenchmarks(
+      "DOOM Combat Scene (binary little endian)", "models/Doom combat scene.ply", Format::BinaryLittleEndian);
+  registerParseBenchmarks(
+      "PBRT-v3 Dragon (binary little endian)", "models/dragon_remeshed.ply", Format::BinaryLittleEndian);
+
+  registerParseBenchmarks("Dragon (ASCII)", "models/dragon_vrip.ply", Format::Ascii);
+  registerParseBenchmarks("Happy Buddha (ASCII)", "models/happy_vrip.ply", Format::Ascii);
+  registerParseBenchmarks("Stanford Bunny (ASCII)", "models/bun_zipper.ply", Format::Ascii);
+}
+
+// Registers parse benchmarks for all models found in the given directory or
+// manifest file, see `findModels()`, instead of the models in `models/`.
+static void registerFoundModelParseBenchmarks(const std::filesystem::path &path)
+{
+  const std::vector<ModelFile> models = findModels(path);
+  if (models.empty()) { std::cerr << "***WARNING*** No models found in '" << path.string() << "'.\n"; }
+
+  for (const ModelFile &model : models)
+  {
+    if (!model.header)
+    {
+      std::cerr << "***WARNING*** Could not read the header of '" << model.filename.string()
+                << "'; skipping model.\n";
+    }
+    else if (!hasTriangleMeshLayout(*model.header))
+    {
+      std::cerr << "***WARNING*** '" << model.filename.string()
+                << "' does not define vertex positions and face vertex indices; skipping model.\n";
+    }
+    else { registerParseBenchmarks(model.name, model.filename, model.header->format); }
+  }
+}
+
+// Registers parse benchmarks for the synthetic corpus for all sizes in the size
+// sweep, for models of meshes of the given type. Models are generated on demand
+// right before the first benchmark that needs them runs, so that sizes that are
+// filtered out are never generated.
+template<typename Mesh = TriangleMesh>
+static void registerCorpusParseBenchmarks(
+    const std::filesystem::path &directory,
+    const std::vector<std::int64_t> &sizes,
+    const std::vector<MeshShape> &shapes)
+{
+  const bool attributed = std::is_same_v<Mesh, AttributedTriangleMesh>;
+  for (std::int64_t numTriangles : sizes)
+  {
+    for (const GeneratedModel &model : corpusModels(directory, numTriangles, 0, shapes, attributed))
+    {
+      auto prepare = [directory, model]() {
+        generateCorpus(directory, model.numTriangles, model.seed, {model.shape}, model.attributed);
+        return std::filesystem::exists(model.filename);
+      };
+      registerParseBenchmarks<Mesh>(model.name, model.filename, model.format, prepare);
+    }
+  }
+}
+
+// Registers parse benchmarks for the polygon models of the synthetic corpus for
+// all sizes in the size sweep, for all libraries that are able to read lists of
+// varying length. Every model is parsed into a polygon mesh, and, as a separate
+// benchmark, triangulated on load. Like the triangle models, polygon models are
+// generated on demand. Sizes above `maxPolygonFaces` are skipped.
+static void registerPolygonParseBenchmarks(
+    const std::filesystem::path &directory, const std::vector<std::int64_t> &sizes)
+{
+  for (std::int64_t numFaces : sizes)
+  {
+    if (numFaces > maxPolygonFaces) { continue; }
+
+    for (const GeneratedPolygonModel &model : polygonCorpusModels(directory, std::int32_t(numFaces)))
+    {
+      auto prepare = [directory, model]() {
+        generatePolygonCorpus(directory, model.numFaces, model.seed, {model.mix});
+        return std::filesystem::exists(model.filename);
+      };
+
+      for (const ParserBackend &backend : parserBackends())
+      {
+        if (!backend.parsePolygon || !backend.supports(model.format)) { continue; }
+
+        for (bool triangulateOnLoad : {false, true})
+        {
+          const std::string name{
+              "BM_ParsePolygons" + backend.benchmarkName + '/' + model.name +
+              (triangulateOnLoad ? "/triangulated" : "")};
+          registrations.push_back(
+              [&backend, name, filename = model.filename.string(), prepare, triangulateOnLoad]() {
+                return registerBenchmark(
+                           name,
+                           [&backend, filename, prepare, triangulateOnLoad](benchmark::State &state) {
+                             if (!prepare())
+                             {
+                               state.SkipWithError(
+                                   (std::string{"could not generate '"} + filename + "'").data());
+                               return;
+                             }
+                             BM_ParsePolygons(state, backend, filename, triangulateOnLoad);
+                           })
+                    ->Unit(TIME_UNIT);
+              });
+        }
+      }
+    }
+  }
+}
+
+// Registers parse benchmarks for the models of the synthetic corpus of the given
+// shape that store the types of every precision, for all sizes in the size sweep,
+// which parse these models into triangle meshes of every precision, to measure
+// the cost of converting between types. Benchmarks are only registered for the
+// libraries that convert types, and are named after the model, with a suffix
+// for the requested types unless these are `float` and `int`, like
+// `BM_ParseRPly/Sphere with double coordinates 1K (ASCII)/as ushort indices`.
+// Parsing the regular corpus models into a `TriangleMesh` is left to the corpus
+// benchmarks.
+static void registerPrecisionParseBenchmarks(
+    const std::filesystem::path &directory, const std::vector<std::int64_t> &sizes, MeshShape shape)
+{
+  std::vector<GeneratedModel> models;
+  for (std::int64_t numTriangles : sizes)
+  {
+    for (MeshPrecision precision : meshPrecisions)
+    {
+      // Models with 64-bit indices store them as `uint`, like the models with
+      // `uint` indices.
+      if (precision == MeshPrecision::Int64) { continue; }
+
+      const std::vector<GeneratedModel> precisionModels =
+          corpusModels(directory, numTriangles, 0, {shape}, false, precision);
+      models.insert(models.end(), precisionModels.begin(), precisionModels.end());
+    }
+  }
+
+  for (const GeneratedModel &model : models)
+  {
+    auto prepare = [directory, model]() {
+      generateCorpus(directory, model.numTriangles, model.seed, {model.shape}, false, model.precision);
+      return std::filesystem::exists(model.filename);
+    };
+
+    for (const ParserBackend &backend : parserBackends())
+    {
+      if (!std::get<0>(backend.parseAs) || !backend.supports(model.format)) { continue; }
+
+      for (MeshPrecision precision : meshPrecisions)
+      {
+        if (model.precision == MeshPrecision::Float && precision == MeshPrecision::Float) { continue; }
+        if (!backend.supports(model.precision, precision)) { continue; }
+
+        // Every shape has more than half as many vertices as triangles.
+        const std::size_t maxVertices =
+            std::min(maxMeshVertices(model.precision), maxMeshVertices(precision));
+        if (std::size_t(model.numTriangles) / 2 >= maxVertices) { continue; }
+
+        ParseOptions options;
+        options.name = "BM_Parse" + backend.benchmarkName + '/' + model.name;
+        if (precision != MeshPrecision::Float) { options.name += "/as " + meshPrecisionToString(precision); }
+        options.convertTypes = true;
+        const std::string filename = model.filename.string();
+        registrations.push_back([&backend, filename, options, prepare, precision]() {
+          return registerBenchmark(
+                     options.name,
+                     [&backend, filename, options, prepare, precision](benchmark::State &state) {
+                       if (!prepare())
+                       {
+                         state.SkipWithError(("could not generate '" + filename + "'").data());
+                         return;
+                       }
+                       BM_ParseAs(state, backend, filename, options, precision);
+                     })
+              ->Unit(TIME_UNIT);
+        });
+      }
+    }
+  }
+}
+
+// Registers parse benchmarks for a model with 64-bit indices of the given shape
+// and number of triangles, which may have more vertices than 32-bit indices are
+// able to address. The model is streamed to file, and the parsed mesh is checked
+// against a stream of the generated mesh, so that only the parsed mesh is held
+// in memory.
+static void registerHugeParseBenchmarks(
+    const std::filesystem::path &directory,
+    std::int64_t numTriangles,
+    MeshShape shape)
+{
+  const std::vector<GeneratedModel> models =
+      corpusModels(directory, numTriangles, 0, {shape}, false, MeshPrecision::Int64);
+  for (const GeneratedModel &model : models)
+  {
+    for (const ParserBackend &backend : parserBackends())
+    {
+      if (!backend.supports(MeshPrecision::Int64) || !backend.supports(model.format)) { continue; }
+
+      ParseOptions options;
+      options.name = "BM_Parse" + backend.benchmarkName + '/' + model.name;
+      options.convertTypes = true;
+      options.generatedMesh = model.stream();
+      registrations.push_back([&backend, model, options]() {
+        return registerBenchmark(
+                   options.name,
+                   [&backend, model, options](benchmark::State &state) {
+                     if (!generateModel(model))
+                     {
+                       state.SkipWithError(("could not generate '" + model.filename.string() + "'").data());
+                       return;
+                     }
+                     BM_Parse<Int64TriangleMesh>(state, backend, model.filename, options);
+                   })
+            ->Unit(TIME_UNIT);
+      });
+    }
+  }
+}
+
+// Registers write benchmarks for meshes of the given type; the names of the
+// benchmarks for attributed meshes contain an `attributed` component, and those
+// for structure of arrays meshes an `SoA` component.
+template<typename Mesh = TriangleMesh>
+static void registerWriteBenchmarks(const std::vector<std::int64_t> &sizes)
+{
+  const bool attributed = std::is_same_v<Mesh, AttributedTriangleMesh>;
+  const bool soa = std::is_same_v<Mesh, SoaTriangleMesh>;
+
+  for (const WriterBackend &backend : writerBackends())
+  {
+    if (soa && !backend.writeSoa) { continue; }
+
+    for (Format format : backend.formats)
+    {
+      for (OutputSinkType sink : outputSinks)
+      {
+        if (!backend.supports(sink)) { continue; }
+
+        for (const MallocConfig &mallocConfig : mallocConfigs)
+        {
+          for (bool coldCpuCache : {false, true})
+          {
+            if (coldCpuCache && !registerColdCpuCacheBenchmarks) { continue; }
+
+            const WriteOptions options{
+                sink, sink == OutputSinkType::Tmpfs ? tmpfsDirectory : diskDirectory, writeBufferSize,
+                coldCpuCache, mallocConfig};
+            const std::string name{
+                "BM_Write" + backend.benchmarkName + '/' + (format == Format::Ascii ? "ASCII" : "binary") +
+                (attributed ? "/attributed" : "") + (soa ? "/SoA" : "") +
+                (sink != OutputSinkType::Disk ? '/' + outputSinkTypeToString(sink) : "") +
+                (coldCpuCache ? "/cold CPU cache" : "") +
+                (mallocConfig.isDefault() ? "" : "/malloc:" + mallocConfig.name())};
+            for (std::int64_t numTriangles : sizes)
+            {
+              registrations.push_back([&backend, format, options, name, numTriangles]() {
+                return registerBenchmark(name,
+                                         [&backend, format, options](benchmark::State &state) {
+                                           BM_Write<Mesh>(state, backend, format, options);
+                                         })
+                    ->Unit(TIME_UNIT)
+                    ->ArgName("triangles")
+                    ->Arg(numTriangles);
+              });
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Registers concurrent parse benchmarks for all PLY libraries, for a model from
+// the synthetic corpus in all formats, running up to the given number of threads.
+// In the 'different models' mode, every thread parses a model of the same shape
+// and size that was generated using a different seed.
+static void registerConcurrentParseBenchmarks(
+    const std::filesystem::path &directory,
+    std::int64_t numTriangles,
+    MeshShape shape,
+    int maxThreads)
+{
+  std::vector<std::vector<GeneratedModel>> modelsBySeed;
+  for (int seed = 0; seed < maxThreads; ++seed)
+  {
+    modelsBySeed.push_back(corpusModels(directory, numTriangles, seed, {shape}));
+  }
+
+  // Every number of threads is a separate case, the same numbers of threads as
+  // `ThreadRange(1, maxThreads)` would run.
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2) { threadCounts.push_back(threads); }
+  threadCounts.push_back(maxThreads);
+
+  for (std::size_t i = 0; i < modelsBySeed.front().size(); ++i)
+  {
+    const GeneratedModel &model = modelsBySeed.front()[i];
+
+    std::vector<std::string> differentFilenames;
+    for (const std::vector<GeneratedModel> &models : modelsBySeed)
+    {
+      differentFilenames.push_back(models[i].filename);
+    }
+
+    // Models are generated by the first benchmark thread that needs them; a mutex
+    // makes sure the other threads wait for the models to be written.
+    auto prepare = [directory, model, maxThreads]() {
+      static std::mutex mutex;
+      std::lock_guard<std::mutex> lock{mutex};
+
+      bool success = true;
+      for (int seed = 0; seed < maxThreads; ++seed)
+      {
+        success &= generateCorpus(directory, model.numTriangles, seed, {model.shape}).size() == 3;
+      }
+      return success;
+    };
+
+    for (const ParserBackend &backend : parserBackends())
+    {
+      if (!backend.supports(model.format)) { continue; }
+
+      for (bool sameModel : {true, false})
+      {
+        const std::vector<std::string> filenames{
+            differentFilenames.begin(), differentFilenames.begin() + (sameModel ? 1 : maxThreads)};
+        const std::string mode = sameModel ? "same model" : "different models";
+        const std::string name{"BM_ConcurrentParse" + backend.benchmarkName + '/' + model.name + '/' + mode};
+
+        for (int threads : threadCounts)
+        {
+          registrations.push_back([&backend, filenames, prepare, name, threads]() {
+            return registerBenchmark(
+                       name,
+                       [&backend, filenames, prepare](benchmark::State &state) {
+                         if (!prepare())
+                         {
+                           state.SkipWithError("could not generate the models to parse");
+                           return;
+                         }
+                         BM_ConcurrentParse(state, backend, filenames);
+                       })
+                ->Threads(threads)
+                ->UseRealTime()
+                ->Unit(TIME_UNIT);
+          });
+        }
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  interleavedRepetitions = std::stoll(extractFlag(argc, argv, "interleave_repetitions").value_or("0"));
+  const std::uint64_t interleaveSeed = std::stoull(
+      extractFlag(argc, argv, "interleave_seed").value_or(std::to_string(std::random_device{}())));
+  isolationEnabled = extractFlag(argc, argv, "isolate").value_or("false") == "true";
+  if (const std::optional<std::string> configs = extractFlag(argc, argv, "malloc_configs"))
+  {
+    const std::optional<std::vector<MallocConfig>> parsedConfigs = parseMallocConfigs(*configs);
+    if (!parsedConfigs)
+    {
+      std::cerr << "invalid malloc configurations: '" << *configs << "'\n";
+      return 1;
+    }
+    for (const MallocConfig &config : *parsedConfigs)
+    {
+      if (!config.isDefault()) { mallocConfigs.push_back(config); }
+    }
+  }
+  // Malloc parameters cannot be fully restored within a process, so every
+  // benchmark runs in a child process of its own as soon as any are changed.
+  if (mallocConfigs.size() > 1) { isolationEnabled = true; }
+
+  // In interleaved and isolated mode, the file passed using `--benchmark_out` is
+  // written by a reporter created here, rather than by the benchmark library,
+  // since child processes in isolated mode would otherwise overwrite it.
+  std::optional<std::string> benchmarkOut;
+  std::optional<std::string> benchmarkOutFormat;
+  if (interleavedRepetitions > 0 || isolationEnabled)
+  {
+    benchmarkOut = extractArgument(argc, argv, "--benchmark_out");
+    benchmarkOutFormat = extractArgument(argc, argv, "--benchmark_out_format");
+    if (benchmarkOutFormat && *benchmarkOutFormat != "json" && *benchmarkOutFormat != "console")
+    {
+      std::cerr << "unsupported benchmark output format for interleaved and isolated runs: '"
+                << *benchmarkOutFormat << "'; use 'json' or 'console'\n";
+      return 1;
+    }
+  }
+
+  benchmark::Initialize(&argc, argv);
+
+  const std::filesystem::path corpusDirectory{
+      extractFlag(argc, argv, "corpus_dir").value_or("models/generated")};
+  const std::vector<MeshShape> corpusShapes =
+      parseMeshShapes(extractFlag(argc, argv, "corpus_shapes").value_or("scanned_surface"));
+  const std::optional<std::string> models = extractFlag(argc, argv, "models");
+
+  const std::int64_t sweepMin = std::stoll(extractFlag(argc, argv, "sweep_min").value_or("1000"));
+  const std::int64_t sweepMax = std::stoll(extractFlag(argc, argv, "sweep_max").value_or("100000000"));
+  const std::int64_t sweepMultiplier = std::stoll(extractFlag(argc, argv, "sweep_multiplier").value_or("10"));
+  const std::vector<std::int64_t> sizes = sweepSizes(sweepMin, sweepMax, sweepMultiplier);
+
+  const std::string concurrency = extractFlag(argc, argv, "concurrency").value_or("0");
+  const int maxThreads =
+      concurrency == "max" ? int(std::thread::hardware_concurrency()) : std::stoi(concurrency);
+  const std::int64_t concurrencyNumTriangles =
+      std::stoll(extractFlag(argc, argv, "concurrency_triangles").value_or("1000000"));
+
+  registerColdPageCacheBenchmarks = extractFlag(argc, argv, "cold_page_cache").value_or("false") == "true";
+
+  // By default, twice the size of the largest CPU cache is written to evict the
+  // CPU caches, or 64 MiB in case the cache sizes are unknown.
+  registerColdCpuCacheBenchmarks = extractFlag(argc, argv, "cold_cpu_cache").value_or("false") == "true";
+  cpuCacheFlushSize = std::stoull(extractFlag(argc, argv, "cpu_cache_flush_size").value_or("0"));
+  if (cpuCacheFlushSize == 0)
+  {
+    for (const benchmark::CPUInfo::CacheInfo &cache : benchmark::CPUInfo::Get().caches)
+    {
+      cpuCacheFlushSize = std::max<std::size_t>(cpuCacheFlushSize, 2 * std::size_t(cache.size));
+    }
+    if (cpuCacheFlushSize == 0) { cpuCacheFlushSize = 64 << 20; }
+  }
+  inputSources = parseInputSources(extractFlag(argc, argv, "input_sources").value_or("file"));
+  outputSinks = parseOutputSinks(extractFlag(argc, argv, "write_sinks").value_or("disk"));
+  tmpfsDirectory = extractFlag(argc, argv, "tmpfs_dir").value_or("/dev/shm");
+  diskDirectory = extractFlag(argc, argv, "disk_dir").value_or("");
+  writeBufferSize = std::stoull(extractFlag(argc, argv, "write_buffer_size").value_or("0"));
+  memoryStatsEnabled = extractFlag(argc, argv, "memory_stats").value_or("false") == "true";
+  syscallStatsEnabled = extractFlag(argc, argv, "syscall_stats").value_or("false") == "true";
+  latencyEnabled = extractFlag(argc, argv, "latency").value_or("false") == "true";
+  latencyHistogramEnabled = extractFlag(argc, argv, "latency_histogram").value_or("false") == "true";
+  latencyEnabled = latencyEnabled || latencyHistogramEnabled;
+  const bool attributesEnabled = extractFlag(argc, argv, "attributes").value_or("false") == "true";
+  const bool polygonsEnabled = extractFlag(argc, argv, "polygons").value_or("false") == "true";
+  const bool soaEnabled = extractFlag(argc, argv, "soa").value_or("false") == "true";
+  const bool precisionEnabled = extractFlag(argc, argv, "precision").value_or("false") == "true";
+  const std::int64_t hugeNumTriangles = std::stoll(extractFlag(argc, argv, "huge_triangles").value_or("0"));
+
+  // The helper for the time to mesh benchmarks is built next to the benchmark
+  // executable.
+  if (extractFlag(argc, argv, "time_to_mesh").value_or("false") == "true")
+  {
+    std::error_code ec;
+    loadMeshHelper = std::filesystem::read_symlink("/proc/self/exe", ec).parent_path() / "plybench_load_mesh";
+    if (ec || access(loadMeshHelper.c_str(), X_OK) != 0)
+    {
+      std::cerr << "***WARNING*** Could not find '" << loadMeshHelper.string()
+                << "'; continuing without time to mesh benchmarks.\n";
+      loadMeshHelper.clear();
+    }
+  }
+
+  traceFilename = extractFlag(argc, argv, "trace").value_or("");
+  phaseTimingEnabled =
+      extractFlag(argc, argv, "phase_timing").value_or("false") == "true" || !traceFilename.empty();
+
+  perfCountersEnabled = extractFlag(argc, argv, "perf_counters").value_or("false") == "true";
+  if (perfCountersEnabled && !PerfCounters{}.available())
+  {
+    std::cerr << "***WARNING*** Hardware performance counters are not available, check "
+                 "/proc/sys/kernel/perf_event_paranoid; continuing without performance counters.\n";
+    perfCountersEnabled = false;
+  }
+
+  if (isolationEnabled && !traceFilename.empty())
+  {
+    std::cerr << "***WARNING*** Traces are not supported for isolated runs; continuing without a trace.\n";
+    traceFilename.clear();
+  }
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+
+  if (models) { registerFoundModelParseBenchmarks(*models); }
+  else { registerModelParseBenchmarks(); }
+  registerCorpusParseBenchmarks(corpusDirectory, sizes, corpusShapes);
+  registerWriteBenchmarks(sizes);
+  if (attributesEnabled)
+  {
+    registerCorpusParseBenchmarks<AttributedTriangleMesh>(corpusDirectory, sizes, corpusShapes);
+    registerWriteBenchmarks<AttributedTriangleMesh>(sizes);
+  }
+  if (soaEnabled)
+  {
+    registerCorpusParseBenchmarks<SoaTriangleMesh>(corpusDirectory, sizes, corpusShapes);
+    registerWriteBenchmarks<SoaTriangleMesh>(sizes);
+  }
+  if (polygonsEnabled) { registerPolygonParseBenchmarks(corpusDirectory, sizes); }
+  if (precisionEnabled)
+  {
+    registerPrecisionParseBenchmarks(
+        corpusDirectory, sizes, corpusShapes.empty() ? MeshShape::ScannedSurface : corpusShapes.front());
+  }
+  if (hugeNumTriangles > 0)
+  {
+    // The scanned surface shape shuffles its vertices and triangles, and cannot
+    // be streamed.
+    const auto shape = std::find_if(corpusShapes.begin(), corpusShapes.end(), MeshStream::supports);
+    registerHugeParseBenchmarks(
+        corpusDirectory, hugeNumTriangles, shape == corpusShapes.end() ? MeshShape::Sphere : *shape);
+  }
+  if (maxThreads > 0)
+  {
+    registerConcurrentParseBenchmarks(
+        corpusDirectory, concurrencyNumTriangles,
+        corpusShapes.empty() ? MeshShape::ScannedSurface : corpusShapes.front(), maxThreads);
+  }
+
+  registerBenchmarks(interleaveSeed);
+
+  if (interleavedRepetitions > 0 || isolationEnabled)
+  {
+    auto wrap = [](std::unique_ptr<benchmark::BenchmarkReporter> reporter) {
+      if (interleavedRepetitions > 0)
+      {
+        reporter = std::make_unique<InterleavedReporter>(std::move(reporter), interleavedRepetitions);
+      }
+      if (isolationEnabled) { reporter = std::make_unique<IsolatedReporter>(std::move(reporter)); }
+      return reporter;
+    };
+
+    if (interleavedRepetitions > 0)
+    {
+      benchmark::AddCustomContext("plybench_interleave_seed", std::to_string(interleaveSeed));
+    }
+    if (isolationEnabled) { benchmark::AddCustomContext("plybench_isolated", "true"); }
+
+    std::vector<std::unique_ptr<benchmark::BenchmarkReporter>> reporters;
+    reporters.push_back(
+        wrap(std::unique_ptr<benchmark::BenchmarkReporter>{benchmark::CreateDefaultDisplayReporter()}));
+
+    std::ofstream outputFile;
+    if (benchmarkOut)
+    {
+      outputFile.open(*benchmarkOut);
+      if (!outputFile)
+      {
+        std::cerr << "invalid file name: '" << *benchmarkOut << "'\n";
+        return 1;
+      }
+
+      std::unique_ptr<benchmark::BenchmarkReporter> reporter;
+      if (benchmarkOutFormat == "console")
+      {
+        reporter = std::make_unique<benchmark::ConsoleReporter>(benchmark::ConsoleReporter::OO_None);
+      }
+      else { reporter = std::make_unique<benchmark::JSONReporter>(); }
+      reporter = wrap(std::move(reporter));
+      reporter->SetOutputStream(&outputFile);
+      reporters.push_back(std::move(reporter));
+    }
+
+    TeeReporter reporter{std::move(reporters)};
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+  }
+  else { benchmark::RunSpecifiedBenchmarks(); }
+
+  if (!traceFilename.empty() && !writeTrace(traceFilename))
+  {
+    std::cerr << "***WARNING*** Could not write trace to '" << traceFilename << "'.\n";
+  }
+  benchmark::Shutdown();
+
+  return 0;
+}
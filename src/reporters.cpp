@@ -0,0 +1,395 @@
+#include "reporters.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include <unistd.h>
+
+namespace {
+double mean(const std::vector<double> &values)
+{
+  return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+double median(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  const std::size_t mid = values.size() / 2;
+  return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+double stddev(const std::vector<double> &values)
+{
+  if (values.size() < 2) { return 0; }
+
+  const double m = mean(values);
+  double sum = 0;
+  for (double value : values) { sum += (value - m) * (value - m); }
+  return std::sqrt(sum / (values.size() - 1));
+}
+
+double cv(const std::vector<double> &values)
+{
+  const double m = mean(values);
+  return m != 0 ? stddev(values) / m : 0;
+}
+
+// Runs received from the child process of the benchmark case that is currently
+// running, in isolated mode.
+std::vector<benchmark::BenchmarkReporter::Run> childRuns;
+
+// Returns pointers to all components of the name of a run.
+template<typename Run>
+auto nameComponents(Run &run)
+{
+  auto &name = run.run_name;
+  return std::array{&name.function_name, &name.args,        &name.min_time,  &name.min_warmup_time,
+                    &name.iterations,    &name.repetitions, &name.time_type, &name.threads};
+}
+
+template<typename T>
+void put(std::string &buffer, const T &value)
+{
+  static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void put(std::string &buffer, const std::string &value)
+{
+  put(buffer, value.size());
+  buffer.append(value);
+}
+
+void put(std::string &buffer, const benchmark::BenchmarkReporter::Run &run)
+{
+  for (const std::string *component : nameComponents(run)) { put(buffer, *component); }
+  put(buffer, run.family_index);
+  put(buffer, run.per_family_instance_index);
+  put(buffer, run.run_type);
+  put(buffer, run.aggregate_name);
+  put(buffer, run.aggregate_unit);
+  put(buffer, run.report_label);
+  put(buffer, run.error_occurred);
+  put(buffer, run.error_message);
+  put(buffer, run.iterations);
+  put(buffer, run.threads);
+  put(buffer, run.repetition_index);
+  put(buffer, run.repetitions);
+  put(buffer, run.time_unit);
+  put(buffer, run.real_accumulated_time);
+  put(buffer, run.cpu_accumulated_time);
+  put(buffer, run.max_heapbytes_used);
+  put(buffer, run.counters.size());
+  for (const auto &[name, counter] : run.counters)
+  {
+    put(buffer, name);
+    put(buffer, counter.value);
+    put(buffer, counter.flags);
+    put(buffer, counter.oneK);
+  }
+}
+
+// Reads values written using `put()`; reading past the end of the data sets the
+// reader to failed, after which all reads are no-ops.
+class Reader
+{
+public:
+  explicit Reader(const std::string &data) : data_{data} {}
+
+  bool failed() const { return failed_; }
+  bool atEnd() const { return offset_ == data_.size(); }
+
+  template<typename T>
+  void get(T &value)
+  {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+    if (failed_ || data_.size() - offset_ < sizeof(value))
+    {
+      failed_ = true;
+      return;
+    }
+    std::memcpy(&value, data_.data() + offset_, sizeof(value));
+    offset_ += sizeof(value);
+  }
+
+  void get(std::string &value)
+  {
+    std::size_t size = 0;
+    get(size);
+    if (failed_ || data_.size() - offset_ < size)
+    {
+      failed_ = true;
+      return;
+    }
+    value.assign(data_, offset_, size);
+    offset_ += size;
+  }
+
+  void get(benchmark::BenchmarkReporter::Run &run)
+  {
+    for (std::string *component : nameComponents(run)) { get(*component); }
+    get(run.family_index);
+    get(run.per_family_instance_index);
+    get(run.run_type);
+    get(run.aggregate_name);
+    get(run.aggregate_unit);
+    get(run.report_label);
+    get(run.error_occurred);
+    get(run.error_message);
+    get(run.iterations);
+    get(run.threads);
+    get(run.repetition_index);
+    get(run.repetitions);
+    get(run.time_unit);
+    get(run.real_accumulated_time);
+    get(run.cpu_accumulated_time);
+    get(run.max_heapbytes_used);
+    std::size_t numCounters = 0;
+    get(numCounters);
+    for (std::size_t i = 0; i < numCounters && !failed_; ++i)
+    {
+      std::string name;
+      benchmark::Counter counter;
+      get(name);
+      get(counter.value);
+      get(counter.flags);
+      get(counter.oneK);
+      run.counters[name] = counter;
+    }
+    run.statistics = nullptr;
+  }
+
+private:
+  const std::string &data_;
+  std::size_t offset_{0};
+  bool failed_{false};
+};
+}
+
+InterleavedReporter::InterleavedReporter(
+    std::unique_ptr<benchmark::BenchmarkReporter> reporter, std::int64_t repetitions)
+    : reporter_{std::move(reporter)}, repetitions_{repetitions}
+{
+}
+
+bool InterleavedReporter::ReportContext(const Context &context)
+{
+  // The benchmark library sets the streams of this reporter, for example to the
+  // file passed using `--benchmark_out`.
+  reporter_->SetOutputStream(&GetOutputStream());
+  reporter_->SetErrorStream(&GetErrorStream());
+  return reporter_->ReportContext(context);
+}
+
+void InterleavedReporter::ReportRuns(const std::vector<Run> &reports)
+{
+  std::vector<Run> annotated;
+  for (Run run : reports)
+  {
+    // Every case is registered using a single repetition; drop the resulting
+    // 'repeats:1' from the name, so that names match those of regular runs.
+    run.run_name.repetitions.clear();
+
+    const std::string name = run.benchmark_name();
+    auto it = runs_.find(name);
+    if (it == runs_.end())
+    {
+      names_.push_back(name);
+      it = runs_.emplace(name, std::vector<Run>{}).first;
+    }
+
+    run.repetitions = repetitions_;
+    run.repetition_index = it->second.size();
+    it->second.push_back(run);
+    annotated.push_back(run);
+  }
+
+  reporter_->ReportRuns(annotated);
+}
+
+void InterleavedReporter::Finalize()
+{
+  using Statistic = std::pair<const char *, std::function<double(const std::vector<double> &)>>;
+  const Statistic statistics[] = {{"mean", mean}, {"median", median}, {"stddev", stddev}, {"cv", cv}};
+
+  for (const std::string &name : names_)
+  {
+    std::vector<Run> runs;
+    for (const Run &run : runs_[name])
+    {
+      if (!run.error_occurred) { runs.push_back(run); }
+    }
+    if (runs.size() < 2) { continue; }
+
+    // Times are aggregated per iteration, since the number of iterations may
+    // differ between repetitions.
+    std::vector<double> realTimes, cpuTimes;
+    std::map<std::string, std::vector<double>> counters;
+    for (const Run &run : runs)
+    {
+      realTimes.push_back(run.real_accumulated_time / run.iterations);
+      cpuTimes.push_back(run.cpu_accumulated_time / run.iterations);
+      for (const auto &[counterName, counter] : run.counters)
+      {
+        counters[counterName].push_back(counter.value);
+      }
+    }
+
+    std::vector<Run> aggregates;
+    for (const auto &[statisticName, compute] : statistics)
+    {
+      Run aggregate = runs.front();
+      aggregate.run_type = Run::RT_Aggregate;
+      aggregate.aggregate_name = statisticName;
+      aggregate.aggregate_unit =
+          statisticName == std::string{"cv"} ? benchmark::kPercentage : benchmark::kTime;
+      aggregate.repetition_index = Run::no_repetition_index;
+      aggregate.iterations = runs.size();
+
+      // Reporters divide times by the number of iterations, but not percentages.
+      const double scale = aggregate.aggregate_unit == benchmark::kTime ? runs.size() : 1;
+      aggregate.real_accumulated_time = compute(realTimes) * scale;
+      aggregate.cpu_accumulated_time = compute(cpuTimes) * scale;
+      for (auto &[counterName, counter] : aggregate.counters)
+      {
+        const std::vector<double> &values = counters[counterName];
+        counter.value = values.size() == runs.size() ? compute(values) : 0;
+      }
+      aggregate.memory_result = nullptr;
+      aggregate.allocs_per_iter = 0;
+      aggregates.push_back(aggregate);
+    }
+    reporter_->ReportRuns(aggregates);
+  }
+
+  reporter_->Finalize();
+}
+
+TeeReporter::TeeReporter(std::vector<std::unique_ptr<benchmark::BenchmarkReporter>> reporters)
+    : reporters_{std::move(reporters)}
+{
+}
+
+bool TeeReporter::ReportContext(const Context &context)
+{
+  bool success = true;
+  for (const auto &reporter : reporters_) { success &= reporter->ReportContext(context); }
+  return success;
+}
+
+void TeeReporter::ReportRuns(const std::vector<Run> &reports)
+{
+  for (const auto &reporter : reporters_) { reporter->ReportRuns(reports); }
+}
+
+void TeeReporter::Finalize()
+{
+  for (const auto &reporter : reporters_) { reporter->Finalize(); }
+}
+
+void CollectingReporter::ReportRuns(const std::vector<Run> &reports)
+{
+  runs_.insert(runs_.end(), reports.begin(), reports.end());
+}
+
+PipeReporter::PipeReporter(int fd) : fd_{fd} {}
+
+void PipeReporter::addCounters(const benchmark::UserCounters &counters)
+{
+  for (const auto &[name, counter] : counters) { counters_[name] = counter; }
+}
+
+void PipeReporter::ReportRuns(const std::vector<Run> &reports)
+{
+  std::string buffer;
+  for (Run run : reports)
+  {
+    for (const auto &[name, counter] : counters_) { run.counters[name] = counter; }
+    put(buffer, run);
+  }
+
+  std::size_t offset = 0;
+  while (offset < buffer.size())
+  {
+    const ssize_t n = write(fd_, buffer.data() + offset, buffer.size() - offset);
+    if (n == -1 && errno == EINTR) { continue; }
+    if (n <= 0) { return; }
+    offset += n;
+  }
+}
+
+std::optional<std::vector<benchmark::BenchmarkReporter::Run>> readRuns(int fd)
+{
+  std::string data;
+  char buffer[65536];
+  for (;;)
+  {
+    const ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n == -1 && errno == EINTR) { continue; }
+    if (n == -1) { return std::nullopt; }
+    if (n == 0) { break; }
+    data.append(buffer, n);
+  }
+
+  std::vector<benchmark::BenchmarkReporter::Run> runs;
+  Reader reader{data};
+  while (!reader.atEnd() && !reader.failed())
+  {
+    benchmark::BenchmarkReporter::Run run;
+    reader.get(run);
+    runs.push_back(run);
+  }
+
+  if (reader.failed()) { return std::nullopt; }
+  return runs;
+}
+
+IsolatedReporter::IsolatedReporter(std::unique_ptr<benchmark::BenchmarkReporter> reporter)
+    : reporter_{std::move(reporter)}
+{
+}
+
+void IsolatedReporter::setChildRuns(std::vector<Run> runs)
+{
+  childRuns = std::move(runs);
+}
+
+bool IsolatedReporter::ReportContext(const Context &context)
+{
+  reporter_->SetOutputStream(&GetOutputStream());
+  reporter_->SetErrorStream(&GetErrorStream());
+  return reporter_->ReportContext(context);
+}
+
+void IsolatedReporter::ReportRuns(const std::vector<Run> &reports)
+{
+  const bool failed =
+      std::any_of(reports.begin(), reports.end(), [](const Run &run) { return run.error_occurred; });
+  if (!failed)
+  {
+    reporter_->ReportRuns(childRuns);
+    return;
+  }
+
+  // A proxy runs a single iteration and repetition, which should not show up in
+  // the name of a failed case.
+  std::vector<Run> runs{reports};
+  for (Run &run : runs)
+  {
+    run.run_name.iterations.clear();
+    run.run_name.repetitions.clear();
+  }
+  reporter_->ReportRuns(runs);
+}
+
+void IsolatedReporter::Finalize()
+{
+  reporter_->Finalize();
+}
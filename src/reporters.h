@@ -0,0 +1,109 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Reporter for interleaved runs, in which every benchmark case is registered
+// once per repetition, each registration running a single repetition. Runs are
+// forwarded to the wrapped reporter as they complete, annotated with their
+// repetition index. When all benchmarks are done, the mean, median, standard
+// deviation and coefficient of variation of every case are reported, as if the
+// repetitions had run consecutively.
+class InterleavedReporter : public benchmark::BenchmarkReporter
+{
+public:
+  InterleavedReporter(std::unique_ptr<benchmark::BenchmarkReporter> reporter, std::int64_t repetitions);
+
+  bool ReportContext(const Context &context) override;
+  void ReportRuns(const std::vector<Run> &reports) override;
+  void Finalize() override;
+
+private:
+  std::unique_ptr<benchmark::BenchmarkReporter> reporter_;
+  std::int64_t repetitions_;
+
+  // Names of all cases in the order they were first reported, and their runs.
+  std::vector<std::string> names_;
+  std::map<std::string, std::vector<Run>> runs_;
+};
+
+// Reporter that forwards everything to a number of reporters, each writing to
+// its own output stream.
+class TeeReporter : public benchmark::BenchmarkReporter
+{
+public:
+  explicit TeeReporter(std::vector<std::unique_ptr<benchmark::BenchmarkReporter>> reporters);
+
+  bool ReportContext(const Context &context) override;
+  void ReportRuns(const std::vector<Run> &reports) override;
+  void Finalize() override;
+
+private:
+  std::vector<std::unique_ptr<benchmark::BenchmarkReporter>> reporters_;
+};
+
+// Reporter that stores all runs.
+class CollectingReporter : public benchmark::BenchmarkReporter
+{
+public:
+  bool ReportContext(const Context &) override { return true; }
+  void ReportRuns(const std::vector<Run> &reports) override;
+
+  const std::vector<Run> &runs() const { return runs_; }
+
+private:
+  std::vector<Run> runs_;
+};
+
+// Reporter for a child process running a benchmark case, that writes all runs
+// to the given file descriptor, to be read by the parent process using
+// `readRuns()`. Only the fields that are printed by the reporters of the
+// benchmark library are transferred.
+class PipeReporter : public benchmark::BenchmarkReporter
+{
+public:
+  explicit PipeReporter(int fd);
+
+  // Adds the given counters to all runs reported from now on.
+  void addCounters(const benchmark::UserCounters &counters);
+
+  bool ReportContext(const Context &) override { return true; }
+  void ReportRuns(const std::vector<Run> &reports) override;
+
+private:
+  int fd_;
+  benchmark::UserCounters counters_;
+};
+
+// Reads all runs written to the given file descriptor by a `PipeReporter` until
+// the end of the stream. Returns std::nullopt in case of a read error, or in
+// case the stream is truncated.
+std::optional<std::vector<benchmark::BenchmarkReporter::Run>> readRuns(int fd);
+
+// Reporter for isolated runs, in which every benchmark case registered in the
+// parent process is a proxy, running the actual case in a child process. The
+// runs of every proxy are replaced by the runs of the child process, passed
+// using `setChildRuns()` by the proxy. Runs of a proxy that failed are
+// forwarded as is.
+class IsolatedReporter : public benchmark::BenchmarkReporter
+{
+public:
+  explicit IsolatedReporter(std::unique_ptr<benchmark::BenchmarkReporter> reporter);
+
+  // Sets the runs of the child process of the benchmark case that is currently
+  // running.
+  static void setChildRuns(std::vector<Run> runs);
+
+  bool ReportContext(const Context &context) override;
+  void ReportRuns(const std::vector<Run> &reports) override;
+  void Finalize() override;
+
+private:
+  std::unique_ptr<benchmark::BenchmarkReporter> reporter_;
+};
@@ -0,0 +1,267 @@
+// Definitions of `read()` and friends below conflict with the inline wrappers
+// that are defined in case of source fortification.
+#undef _FORTIFY_SOURCE
+
+#include "syscall_stats.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace {
+std::atomic<bool> tracking{false};
+
+struct AtomicIoCallStats
+{
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> bytes{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+  std::array<std::atomic<std::uint64_t>, numSizeBuckets> sizes{};
+};
+
+std::array<AtomicIoCallStats, numIoCalls> stats;
+
+std::uint64_t now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return std::uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+int sizeBucket(std::uint64_t bytes)
+{
+  int bucket = 0;
+  while (bucket < numSizeBuckets - 1 && (std::uint64_t{1} << bucket) < bytes) { ++bucket; }
+  return bucket;
+}
+
+void record(IoCall call, std::uint64_t start, std::uint64_t bytes)
+{
+  AtomicIoCallStats &s = stats[int(call)];
+  s.calls.fetch_add(1, std::memory_order_relaxed);
+  s.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  s.nanoseconds.fetch_add(now() - start, std::memory_order_relaxed);
+  s.sizes[sizeBucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Returns the next definition of the given function, which is the one of the C
+// library.
+template<typename Fn>
+Fn next(Fn &fn, const char *name)
+{
+  if (!fn) { fn = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name)); }
+  return fn;
+}
+
+// Calls the next definition of a function, recording the call in case
+// statistics are being gathered. The number of bytes of a call is determined
+// from its result.
+template<typename Fn, typename Bytes, typename... Args>
+auto track(IoCall call, Fn &fn, const char *name, Bytes bytes, Args... args)
+{
+  if (!tracking.load(std::memory_order_relaxed)) { return next(fn, name)(args...); }
+
+  const std::uint64_t start = now();
+  const auto result = next(fn, name)(args...);
+  record(call, start, bytes(result));
+  return result;
+}
+
+std::uint64_t transferred(ssize_t result)
+{
+  return result > 0 ? result : 0;
+}
+
+// Number of read and write system calls according to `/proc/self/io`.
+struct ProcIo
+{
+  std::optional<std::uint64_t> syscr;
+  std::optional<std::uint64_t> syscw;
+};
+
+ProcIo readProcIo()
+{
+  ProcIo result;
+
+  std::FILE *fp = std::fopen("/proc/self/io", "r");
+  if (!fp) { return result; }
+
+  char line[256];
+  while (std::fgets(line, sizeof(line), fp))
+  {
+    unsigned long long value;
+    if (std::sscanf(line, "syscr: %llu", &value) == 1) { result.syscr = value; }
+    else if (std::sscanf(line, "syscw: %llu", &value) == 1) { result.syscw = value; }
+  }
+
+  std::fclose(fp);
+  return result;
+}
+
+ProcIo procIoAtBegin;
+
+using ReadFn = ssize_t (*)(int, void *, size_t);
+using ReadChkFn = ssize_t (*)(int, void *, size_t, size_t);
+using PreadFn = ssize_t (*)(int, void *, size_t, off_t);
+using PreadChkFn = ssize_t (*)(int, void *, size_t, off_t, size_t);
+using WriteFn = ssize_t (*)(int, const void *, size_t);
+using LseekFn = off_t (*)(int, off_t, int);
+using MmapFn = void *(*)(void *, size_t, int, int, int, off_t);
+using FreadFn = size_t (*)(void *, size_t, size_t, FILE *);
+using FreadChkFn = size_t (*)(void *, size_t, size_t, size_t, FILE *);
+using FwriteFn = size_t (*)(const void *, size_t, size_t, FILE *);
+
+ReadFn nextRead;
+ReadChkFn nextReadChk;
+PreadFn nextPread, nextPread64;
+PreadChkFn nextPreadChk, nextPread64Chk;
+WriteFn nextWrite;
+LseekFn nextLseek, nextLseek64;
+MmapFn nextMmap, nextMmap64;
+FreadFn nextFread;
+FreadChkFn nextFreadChk;
+FwriteFn nextFwrite;
+}
+
+const char *ioCallToString(IoCall call)
+{
+  switch (call)
+  {
+    case IoCall::Read:
+      return "read";
+    case IoCall::Pread:
+      return "pread";
+    case IoCall::Write:
+      return "write";
+    case IoCall::Lseek:
+      return "lseek";
+    case IoCall::Mmap:
+      return "mmap";
+    case IoCall::Fread:
+      return "fread";
+    case IoCall::Fwrite:
+      return "fwrite";
+  }
+
+  return "";
+}
+
+void beginSyscallStats()
+{
+  for (AtomicIoCallStats &s : stats)
+  {
+    s.calls = 0;
+    s.bytes = 0;
+    s.nanoseconds = 0;
+    for (std::atomic<std::uint64_t> &size : s.sizes) { size = 0; }
+  }
+
+  procIoAtBegin = readProcIo();
+
+  tracking = true;
+}
+
+SyscallStats endSyscallStats()
+{
+  tracking = false;
+
+  SyscallStats result;
+  for (int call = 0; call < numIoCalls; ++call)
+  {
+    const AtomicIoCallStats &s = stats[call];
+    IoCallStats &r = result.calls[call];
+    r.calls = s.calls;
+    r.bytes = s.bytes;
+    r.seconds = s.nanoseconds / 1e9;
+    for (int bucket = 0; bucket < numSizeBuckets; ++bucket) { r.sizes[bucket] = s.sizes[bucket]; }
+  }
+
+  const ProcIo procIo = readProcIo();
+  if (procIo.syscr && procIoAtBegin.syscr) { result.readSyscalls = *procIo.syscr - *procIoAtBegin.syscr; }
+  if (procIo.syscw && procIoAtBegin.syscw) { result.writeSyscalls = *procIo.syscw - *procIoAtBegin.syscw; }
+
+  return result;
+}
+
+extern "C" {
+ssize_t read(int fd, void *buf, size_t count)
+{
+  return track(IoCall::Read, nextRead, "read", transferred, fd, buf, count);
+}
+
+ssize_t __read_chk(int fd, void *buf, size_t count, size_t buflen)
+{
+  return track(IoCall::Read, nextReadChk, "__read_chk", transferred, fd, buf, count, buflen);
+}
+
+ssize_t pread(int fd, void *buf, size_t count, off_t offset)
+{
+  return track(IoCall::Pread, nextPread, "pread", transferred, fd, buf, count, offset);
+}
+
+ssize_t pread64(int fd, void *buf, size_t count, off_t offset)
+{
+  return track(IoCall::Pread, nextPread64, "pread64", transferred, fd, buf, count, offset);
+}
+
+ssize_t __pread_chk(int fd, void *buf, size_t count, off_t offset, size_t buflen)
+{
+  return track(IoCall::Pread, nextPreadChk, "__pread_chk", transferred, fd, buf, count, offset, buflen);
+}
+
+ssize_t __pread64_chk(int fd, void *buf, size_t count, off_t offset, size_t buflen)
+{
+  return track(IoCall::Pread, nextPread64Chk, "__pread64_chk", transferred, fd, buf, count, offset, buflen);
+}
+
+ssize_t write(int fd, const void *buf, size_t count)
+{
+  return track(IoCall::Write, nextWrite, "write", transferred, fd, buf, count);
+}
+
+off_t lseek(int fd, off_t offset, int whence)
+{
+  return track(IoCall::Lseek, nextLseek, "lseek", [](off_t) { return 0; }, fd, offset, whence);
+}
+
+off_t lseek64(int fd, off_t offset, int whence)
+{
+  return track(IoCall::Lseek, nextLseek64, "lseek64", [](off_t) { return 0; }, fd, offset, whence);
+}
+
+void *mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset)
+{
+  auto mapped = [length](void *result) { return result != MAP_FAILED ? length : 0; };
+  return track(IoCall::Mmap, nextMmap, "mmap", mapped, addr, length, prot, flags, fd, offset);
+}
+
+void *mmap64(void *addr, size_t length, int prot, int flags, int fd, off_t offset)
+{
+  auto mapped = [length](void *result) { return result != MAP_FAILED ? length : 0; };
+  return track(IoCall::Mmap, nextMmap64, "mmap64", mapped, addr, length, prot, flags, fd, offset);
+}
+
+size_t fread(void *ptr, size_t size, size_t n, FILE *stream)
+{
+  auto bytes = [size](size_t result) { return result * size; };
+  return track(IoCall::Fread, nextFread, "fread", bytes, ptr, size, n, stream);
+}
+
+size_t __fread_chk(void *ptr, size_t ptrlen, size_t size, size_t n, FILE *stream)
+{
+  auto bytes = [size](size_t result) { return result * size; };
+  return track(IoCall::Fread, nextFreadChk, "__fread_chk", bytes, ptr, ptrlen, size, n, stream);
+}
+
+size_t fwrite(const void *ptr, size_t size, size_t n, FILE *stream)
+{
+  auto bytes = [size](size_t result) { return result * size; };
+  return track(IoCall::Fwrite, nextFwrite, "fwrite", bytes, ptr, size, n, stream);
+}
+}
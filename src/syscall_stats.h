@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+// I/O calls that are accounted for by the syscall statistics.
+enum class IoCall { Read, Pread, Write, Lseek, Mmap, Fread, Fwrite };
+
+constexpr int numIoCalls = 7;
+
+const char *ioCallToString(IoCall call);
+
+// Number of buckets of the histogram of bytes per call; bucket `i` counts the
+// calls that transferred more than 2^(i-1) and at most 2^i bytes, where bucket
+// zero also counts calls of zero bytes, and the last bucket counts all calls
+// that transferred more bytes than that.
+constexpr int numSizeBuckets = 32;
+
+// Statistics of a single type of I/O call.
+struct IoCallStats
+{
+  std::uint64_t calls{0};
+  // Total number of bytes transferred or mapped; not applicable to `lseek()`.
+  std::uint64_t bytes{0};
+  // Total wall time spent in the calls.
+  double seconds{0};
+  std::array<std::uint64_t, numSizeBuckets> sizes{};
+};
+
+// Statistics of I/O calls, gathered in between calls to `beginSyscallStats()`
+// and `endSyscallStats()`. Calls are tracked by interposing `read()`, `pread()`,
+// `write()`, `lseek()` and `mmap()`; this only works for executables that link
+// in `syscall_stats.cpp`. The C library calls internal aliases of these
+// functions from its stdio implementation, which cannot be interposed, hence
+// `fread()` and `fwrite()` are tracked as well, and the number of read and write
+// system calls accounted by the kernel is reported next to that.
+struct SyscallStats
+{
+  std::array<IoCallStats, numIoCalls> calls;
+  // Number of read and write system calls according to `/proc/self/io`,
+  // including those made internally by the C library, in case available.
+  std::optional<std::uint64_t> readSyscalls;
+  std::optional<std::uint64_t> writeSyscalls;
+};
+
+void beginSyscallStats();
+SyscallStats endSyscallStats();
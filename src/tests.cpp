@@ -1,17 +1,31 @@
+#include "backends.h"
 #include "mesh.h"
 #include "mesh_ios.h"
 #include "parsers.h"
+#include "phases.h"
 #include "util.h"
 #include "writers.h"
 
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace {
+template<typename Mesh>
 std::string meshComparisonInfo(
-    const std::optional<TriangleMesh> &maybeX,
-    const std::optional<TriangleMesh> &maybeY,
+    const std::optional<Mesh> &maybeX,
+    const std::optional<Mesh> &maybeY,
     const std::string &lhsName,
     const std::string &rhsName,
     const std::string &modelFilename)
@@ -24,8 +38,8 @@ std::string meshComparisonInfo(
 
   if (maybeX && maybeY)
   {
-    const TriangleMesh &x = *maybeX;
-    const TriangleMesh &y = *maybeY;
+    const Mesh &x = *maybeX;
+    const Mesh &y = *maybeY;
 
     std::ostringstream oss;
 
@@ -66,6 +80,61 @@ std::string meshComparisonInfo(
 
   return "No comparison information...";
 }
+
+// Returns the FNV-1a hash of the vertex coordinates and triangle indices of the
+// mesh, independent of the index type.
+template<typename Mesh>
+std::uint64_t hashMesh(const Mesh &mesh)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  auto add = [&hash](std::uint64_t value) {
+    for (int byte = 0; byte < 8; ++byte)
+    {
+      hash ^= (value >> (8 * byte)) & 0xff;
+      hash *= 1099511628211ull;
+    }
+  };
+
+  for (const auto &vertex : mesh.vertices)
+  {
+    for (float coordinate : {vertex.x, vertex.y, vertex.z})
+    {
+      std::uint32_t bits;
+      std::memcpy(&bits, &coordinate, sizeof(bits));
+      add(bits);
+    }
+  }
+  for (const auto &triangle : mesh.triangles)
+  {
+    add(std::uint64_t(triangle.a));
+    add(std::uint64_t(triangle.b));
+    add(std::uint64_t(triangle.c));
+  }
+  return hash;
+}
+
+// Directory the synthetic corpus of the tests is generated in.
+std::filesystem::path testCorpusDirectory()
+{
+  return std::filesystem::temp_directory_path() / "plybench-corpus";
+}
+
+// Returns the models of the synthetic corpus of 1000 triangles that the tests
+// verify against, in all formats, generating them when needed.
+std::vector<GeneratedModel> generatedTestModels(bool attributed = false)
+{
+  const std::vector<GeneratedModel> models =
+      generateCorpus(testCorpusDirectory(), 1000, 0, corpusMeshShapes, attributed);
+  REQUIRE(models.size() == 3 * corpusMeshShapes.size());
+  return models;
+}
+
+std::vector<GeneratedPolygonModel> generatedPolygonTestModels()
+{
+  const std::vector<GeneratedPolygonModel> models = generatePolygonCorpus(testCorpusDirectory(), 1000);
+  REQUIRE(models.size() == 3 * polygonMixes.size());
+  return models;
+}
 }
 
 TEST_CASE("Verify parsers against PLYwoot")
@@ -148,6 +217,390 @@ TEST_CASE("Verify tinyply against PLYwoot")
   CHECK(mesh == plywootMesh);
 }
 
+// Verifies all parsers against the synthetic corpus, for which the expected mesh
+// is known up front. In contrast to the tests above, this does not require any
+// models to be downloaded.
+TEST_CASE("Verify parsers against generated models", "[generated]")
+{
+  const std::vector<GeneratedModel> models = generatedTestModels();
+
+  const GeneratedModel &model = models[GENERATE_COPY(range(std::size_t{0}, models.size()))];
+  const std::optional<TriangleMesh> expectedMesh = model.mesh();
+  REQUIRE(expectedMesh->triangles.size() == 1000);
+
+  for (const ParserBackend &backend : parserBackends())
+  {
+    if (!backend.supports(model.format, readPlyHeader(model.filename))) { continue; }
+
+    const std::optional<TriangleMesh> mesh = backend.parse(model.filename);
+
+    INFO(model.name + ": " +
+         meshComparisonInfo(mesh, expectedMesh, backend.libraryName, "generated", model.filename));
+    CHECK(mesh == expectedMesh);
+  }
+}
+
+// Verifies all parsers against generated models with vertex normals, colors
+// and texture coordinates.
+TEST_CASE("Verify attributed parsers against generated models", "[generated]")
+{
+  const std::vector<GeneratedModel> models = generatedTestModels(true);
+
+  const GeneratedModel &model = models[GENERATE_COPY(range(std::size_t{0}, models.size()))];
+  const std::optional<AttributedTriangleMesh> expectedMesh = model.attributedMesh();
+  REQUIRE(expectedMesh->triangles.size() == 1000);
+  REQUIRE(expectedMesh->triangles == model.mesh().triangles);
+
+  const std::optional<PlyHeader> header = readPlyHeader(model.filename);
+  REQUIRE(header.has_value());
+  REQUIRE(header->element("vertex"));
+  CHECK(header->element("vertex")->properties.size() == 12);
+  CHECK(hasTriangleMeshLayout(*header));
+
+  for (const ParserBackend &backend : parserBackends())
+  {
+    if (!backend.supports(model.format, header)) { continue; }
+
+    const std::optional<AttributedTriangleMesh> mesh = backend.parseAttributed(model.filename);
+
+    INFO(model.name + ": " +
+         meshComparisonInfo(mesh, expectedMesh, backend.libraryName, "generated", model.filename));
+    CHECK(mesh == expectedMesh);
+  }
+}
+
+// Verifies the parsers that fill a structure of arrays directly against the
+// synthetic corpus.
+TEST_CASE("Verify structure of arrays parsers against generated models", "[generated]")
+{
+  const std::vector<GeneratedModel> models = generatedTestModels();
+
+  const GeneratedModel &model = models[GENERATE_COPY(range(std::size_t{0}, models.size()))];
+  const std::optional<SoaTriangleMesh> expectedMesh = toStructureOfArrays(model.mesh());
+  REQUIRE(toArrayOfStructures(*expectedMesh) == model.mesh());
+
+  for (const ParserBackend &backend : parserBackends())
+  {
+    if (!backend.parseSoa || !backend.supports(model.format, readPlyHeader(model.filename))) { continue; }
+
+    INFO(model.name + ": " + backend.libraryName);
+    CHECK(backend.parseSoa(model.filename) == expectedMesh);
+  }
+}
+
+// Verifies the parsers that convert types against generated models storing the
+// types of every precision, parsed into triangle meshes of every precision.
+TEST_CASE("Verify type converting parsers against generated models", "[generated]")
+{
+  const MeshPrecision storedPrecision =
+      GENERATE(MeshPrecision::Float, MeshPrecision::Double, MeshPrecision::UInt32, MeshPrecision::UInt16);
+  const std::vector<GeneratedModel> models =
+      generateCorpus(testCorpusDirectory(), 1000, 0, {MeshShape::Sphere}, false, storedPrecision);
+  REQUIRE(models.size() == 3);
+
+  for (const GeneratedModel &model : models)
+  {
+    const std::optional<PlyHeader> header = readPlyHeader(model.filename);
+    REQUIRE(header.has_value());
+    CHECK(header->element("vertex")->property("x")->type ==
+          (storedPrecision == MeshPrecision::Double ? "double" : "float"));
+    CHECK(
+        header->element("face")->property("vertex_indices")->type ==
+        (storedPrecision == MeshPrecision::UInt32   ? "uint"
+         : storedPrecision == MeshPrecision::UInt16 ? "ushort"
+                                                    : "int"));
+
+    for (MeshPrecision precision : meshPrecisions)
+    {
+      visitMeshPrecision(precision, [&](auto precisionMesh) {
+        using Mesh = decltype(precisionMesh);
+        const std::optional<Mesh> expectedMesh = convertMesh<Mesh>(model.mesh());
+
+        for (const ParserBackend &backend : parserBackends())
+        {
+          const MeshParseFunction<Mesh> parse = std::get<MeshParseFunction<Mesh>>(backend.parseAs);
+          if (!parse || !backend.supports(model.format) || !backend.supports(model.precision, precision))
+          {
+            continue;
+          }
+
+          INFO(model.name + ": " + backend.libraryName + " as " + meshPrecisionToString(precision));
+          const std::optional<Mesh> mesh = parse(model.filename);
+          REQUIRE(mesh.has_value());
+
+          // ASCII models store the shortest decimal representation of each float, which parses to a
+          // different double, but converts back to the same float.
+          if (model.format == Format::Ascii) { CHECK(convertMesh<TriangleMesh>(*mesh) == model.mesh()); }
+          else { CHECK(mesh == expectedMesh); }
+        }
+      });
+    }
+  }
+}
+
+// Verifies that streamed meshes equal the meshes generated in memory, also once
+// written to file, and that differences from a streamed mesh are detected.
+TEST_CASE("Stream generated meshes", "[generated]")
+{
+  const MeshShape shape = GENERATE(MeshShape::Strip, MeshShape::Sphere, MeshShape::NoisyGrid);
+  const std::int64_t numTriangles = GENERATE(1, 2, 7, 1000);
+  INFO(meshShapeToString(shape) + ' ' + std::to_string(numTriangles));
+
+  const TriangleMesh mesh = createMesh(shape, numTriangles, 1);
+  const MeshStream stream{shape, numTriangles, 1};
+  REQUIRE(stream.numVertices() == std::int64_t(mesh.vertices.size()));
+  REQUIRE(stream.numTriangles() == numTriangles);
+  CHECK(matchesGeneratedMesh(mesh, stream));
+  CHECK(matchesGeneratedMesh(convertMesh<Int64TriangleMesh>(mesh), stream));
+
+  TriangleMesh otherVertex = mesh;
+  otherVertex.vertices.back().z += 1;
+  CHECK_FALSE(matchesGeneratedMesh(otherVertex, stream));
+  TriangleMesh otherTriangle = mesh;
+  std::swap(otherTriangle.triangles.back().a, otherTriangle.triangles.back().b);
+  CHECK_FALSE(matchesGeneratedMesh(otherTriangle, stream));
+
+  for (Format format : {Format::Ascii, Format::BinaryLittleEndian, Format::BinaryBigEndian})
+  {
+    TemporaryFile expected;
+    TemporaryFile streamed;
+    REQUIRE(writeMesh(convertMesh<Int64TriangleMesh>(mesh), format, expected.filename()));
+    REQUIRE(writeMesh(stream, format, streamed.filename()));
+
+    std::ifstream expectedStream{expected.filename(), std::ios::binary};
+    std::ifstream streamedStream{streamed.filename(), std::ios::binary};
+    CHECK(
+        std::string{std::istreambuf_iterator<char>{streamedStream}, std::istreambuf_iterator<char>{}} ==
+        std::string{std::istreambuf_iterator<char>{expectedStream}, std::istreambuf_iterator<char>{}});
+
+    const std::optional<PlyHeader> header = readPlyHeader(streamed.filename());
+    REQUIRE(header.has_value());
+    CHECK(header->element("face")->property("vertex_indices")->type == "uint");
+  }
+}
+
+// The hashes were recorded with the generator from before the meshes could be
+// streamed, so that the generated corpus stays the same.
+TEST_CASE("Generate the same meshes as before", "[generated]")
+{
+  const auto [shape, numVertices, hash] = GENERATE(table<MeshShape, std::size_t, std::uint64_t>({
+      {MeshShape::Strip, 1002, 0x11407bc2be8053efull},
+      {MeshShape::Sphere, 514, 0xd2331fa1ca5746cfull},
+      {MeshShape::NoisyGrid, 552, 0x2b1eb3206c367210ull},
+      {MeshShape::ScannedSurface, 552, 0x2116f7764a73b339ull},
+  }));
+  INFO(meshShapeToString(shape));
+
+  const TriangleMesh mesh = createMesh(shape, 1000);
+  REQUIRE(mesh.vertices.size() == numVertices);
+  REQUIRE(mesh.triangles.size() == 1000);
+  CHECK(hashMesh(mesh) == hash);
+  CHECK(hashMesh(createMesh<Int64TriangleMesh>(shape, 1000)) == hash);
+}
+
+TEST_CASE("Generate meshes with 64-bit indices", "[generated]")
+{
+  for (MeshShape shape : corpusMeshShapes)
+  {
+    INFO(meshShapeToString(shape));
+    CHECK(
+        createMesh<Int64TriangleMesh>(shape, 1000, 2) ==
+        convertMesh<Int64TriangleMesh>(createMesh(shape, 1000, 2)));
+  }
+  CHECK_FALSE(MeshStream::supports(MeshShape::ScannedSurface));
+
+  // 64-bit indices are stored as `uint`, which addresses at most 2^32 vertices.
+  TemporaryFile file;
+  const MeshStream stream{MeshShape::Strip, std::int64_t{1} << 32};
+  CHECK_FALSE(writeMesh(stream, Format::BinaryLittleEndian, file.filename()));
+}
+
+TEST_CASE("Generate and triangulate polygon meshes", "[generated]")
+{
+  const PolygonMix mix = GENERATE(PolygonMix::QuadDominant, PolygonMix::Mixed);
+  const PolygonMesh mesh = createPolygonMesh(mix, 1000);
+  REQUIRE(mesh.numFaces() == 1000);
+  REQUIRE(mesh.offsets.front() == 0);
+  REQUIRE(mesh.offsets.back() == std::int32_t(mesh.indices.size()));
+  CHECK(createPolygonMesh(mix, 1000) == mesh);
+
+  std::vector<std::size_t> facesBySize(7);
+  for (std::size_t i = 0; i < mesh.numFaces(); ++i)
+  {
+    const std::int32_t size = mesh.offsets[i + 1] - mesh.offsets[i];
+    REQUIRE(size >= 3);
+    REQUIRE(size <= 6);
+    ++facesBySize[size];
+  }
+  for (std::int32_t index : mesh.indices) { REQUIRE(std::size_t(index) < mesh.vertices.size()); }
+
+  if (mix == PolygonMix::QuadDominant)
+  {
+    CHECK(facesBySize[4] > facesBySize[3]);
+    CHECK(facesBySize[5] + facesBySize[6] == 0);
+  }
+  else
+  {
+    for (std::size_t size = 3; size <= 6; ++size) { CHECK(facesBySize[size] > 0); }
+  }
+
+  const TriangleMesh triangleMesh = triangulate(mesh);
+  CHECK(triangleMesh.triangles.size() == countTriangles(mesh));
+  CHECK(triangleMesh.vertices == mesh.vertices);
+  CHECK(triangleMesh.triangles.front().a == mesh.indices[0]);
+
+  // Every face is triangulated as a fan around its first vertex.
+  const PolygonMesh pentagon{{0, 5}, {4, 3, 2, 1, 0}, Vertices(5)};
+  CHECK(triangulate(pentagon).triangles == Triangles{{4, 3, 2}, {4, 2, 1}, {4, 1, 0}});
+}
+
+// Verifies the parsers that read lists of varying length against generated
+// polygon models.
+TEST_CASE("Verify polygon parsers against generated models", "[generated]")
+{
+  const std::vector<GeneratedPolygonModel> models = generatedPolygonTestModels();
+
+  const GeneratedPolygonModel &model = models[GENERATE_COPY(range(std::size_t{0}, models.size()))];
+  const std::optional<PolygonMesh> expectedMesh = model.mesh();
+
+  const std::optional<PlyHeader> header = readPlyHeader(model.filename);
+  REQUIRE(header.has_value());
+  CHECK(header->numFaces == 1000);
+  CHECK(hasTriangleMeshLayout(*header));
+
+  for (const ParserBackend &backend : parserBackends())
+  {
+    if (!backend.parsePolygon || !backend.supports(model.format, header)) { continue; }
+
+    INFO(model.name + ": " + backend.libraryName);
+    CHECK(backend.parsePolygon(model.filename) == expectedMesh);
+  }
+}
+
+TEST_CASE("Read the header of generated models", "[generated]")
+{
+  const std::vector<GeneratedModel> models = generatedTestModels();
+
+  const GeneratedModel &model = models[GENERATE_COPY(range(std::size_t{0}, models.size()))];
+  const TriangleMesh mesh = model.mesh();
+
+  const std::optional<PlyHeader> header = readPlyHeader(model.filename);
+  REQUIRE(header.has_value());
+  CHECK(header->format == model.format);
+  CHECK(header->numVertices == std::int64_t(mesh.vertices.size()));
+  CHECK(header->numFaces == std::int64_t(mesh.triangles.size()));
+  CHECK(header->size > 0);
+  CHECK(header->size < std::filesystem::file_size(model.filename));
+
+  REQUIRE(header->elements.size() == 2);
+  CHECK(header->elements[0].name == "vertex");
+  CHECK(header->elements[0].properties.size() == 3);
+  CHECK(header->elements[0].properties[0].type == "float");
+  CHECK(header->elements[1].name == "face");
+  REQUIRE(header->element("face")->property("vertex_indices"));
+  CHECK(header->element("face")->property("vertex_indices")->sizeType.has_value());
+  CHECK(hasTriangleMeshLayout(*header));
+}
+
+TEST_CASE("Find models in a directory or a manifest", "[generated]")
+{
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "plybench-find-models";
+  std::filesystem::remove_all(directory);
+  const std::vector<GeneratedModel> models = generateCorpus(directory, 1000, 0, {MeshShape::Sphere});
+  REQUIRE(models.size() == 3);
+
+  SECTION("Directory")
+  {
+    const std::vector<ModelFile> found = findModels(directory);
+    REQUIRE(found.size() == 3);
+    for (const ModelFile &model : found)
+    {
+      REQUIRE(model.header.has_value());
+      CHECK(model.name.rfind(model.filename.stem().string() + " (", 0) == 0);
+    }
+  }
+
+  SECTION("Manifest")
+  {
+    const std::filesystem::path manifest = directory / "manifest.txt";
+    {
+      std::ofstream ofs{manifest};
+      ofs << "# Models to benchmark\n\n";
+      ofs << models[0].filename.filename().string() << "\tFirst model\n";
+      ofs << models[1].filename.string() << '\n';
+      ofs << "missing.ply\n";
+    }
+
+    const std::vector<ModelFile> found = findModels(manifest);
+    REQUIRE(found.size() == 3);
+    CHECK(found[0].name == "First model");
+    CHECK(found[0].filename == models[0].filename);
+    CHECK(found[0].header.has_value());
+    CHECK(found[1].filename == models[1].filename);
+    CHECK(found[1].header.has_value());
+    CHECK_FALSE(found[2].header.has_value());
+  }
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Record the phases of parsing a generated model", "[generated]")
+{
+  const std::vector<GeneratedModel> models = generatedTestModels();
+
+  // Note; tinyply 2.3 is broken for ASCII PLY files.
+  auto isBinary = [](const GeneratedModel &model) { return model.format != Format::Ascii; };
+  const auto model = std::find_if(models.begin(), models.end(), isBinary);
+  REQUIRE(model != models.end());
+
+  PhaseRecorder recorder;
+  recorder.recordEvents(true);
+  REQUIRE(parseTinyply(model->filename).has_value());
+
+  for (Phase phase : {Phase::Open, Phase::Header, Phase::Body, Phase::Conversion})
+  {
+    INFO(phaseToString(phase));
+    CHECK(recorder.totals()[int(phase)] > 0);
+  }
+
+  const std::vector<PhaseRecorder::Event> &events = recorder.events();
+  REQUIRE(!events.empty());
+  for (std::size_t i = 1; i < events.size(); ++i) { CHECK(events[i - 1].end <= events[i].start); }
+
+  // Phases are only recorded while a recorder exists.
+  const std::size_t numEvents = events.size();
+  {
+    PhaseRecorder nested;
+    REQUIRE(parseTinyply(model->filename).has_value());
+  }
+  CHECK(recorder.events().size() == numEvents);
+}
+
+// Verifies the parsers that support reading from memory against the synthetic
+// corpus, for all input sources.
+TEST_CASE("Verify parsers reading from memory against generated models", "[generated]")
+{
+  const std::vector<GeneratedModel> models = generatedTestModels();
+
+  const GeneratedModel &model = models[GENERATE_COPY(range(std::size_t{0}, models.size()))];
+  const std::optional<TriangleMesh> expectedMesh = model.mesh();
+
+  const InputSource source = GENERATE(InputSource::File, InputSource::Memory, InputSource::MemoryMap);
+  const ParserInput input{source, model.filename};
+  REQUIRE(input.valid());
+
+  for (const ParserBackend &backend : parserBackends())
+  {
+    if (!backend.parseInput || !backend.supports(model.format)) { continue; }
+
+    const std::optional<TriangleMesh> mesh = backend.parseInput(input);
+
+    INFO(model.name + " (" + inputSourceToString(source) + "): " +
+         meshComparisonInfo(mesh, expectedMesh, backend.libraryName, "generated", model.filename));
+    CHECK(mesh == expectedMesh);
+  }
+}
+
 TEST_CASE("Test functionality of various writer libraries")
 {
   auto format = GENERATE(Format::Ascii, Format::BinaryLittleEndian);
@@ -221,4 +674,88 @@ TEST_CASE("Test functionality of various writer libraries")
   }
 }
 
+// Verifies that the writers that are able to write to a stream or `FILE` handle
+// produce the same output for all output sinks.
+TEST_CASE("Test writer libraries for all output sinks")
+{
+  const Format format = GENERATE(Format::Ascii, Format::BinaryLittleEndian);
+
+  const TriangleMesh mesh = createMesh(1000);
+
+  for (const WriterBackend &backend : writerBackends())
+  {
+    if (!backend.supportsStreams) { continue; }
+
+    INFO(backend.libraryName + " (" + formatToString(format) + ')');
+    const WriteFunction write = backend.write;
+
+    OutputSink disk{OutputSinkType::Disk, {}, 4096};
+    REQUIRE(write(mesh, format, disk));
+    REQUIRE(disk.close());
+
+    const std::optional<TriangleMesh> maybeMesh = parsePlywoot(disk.filename());
+    REQUIRE(maybeMesh.has_value());
+    CHECK(mesh == *maybeMesh);
+
+    std::ifstream ifs{disk.filename(), std::ios::binary};
+    const std::string expected{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+    CHECK(disk.size() == expected.size());
+
+    OutputSink memory{OutputSinkType::Memory};
+    REQUIRE(write(mesh, format, memory));
+    REQUIRE(memory.close());
+    CHECK(memory.data() == expected);
+
+    OutputSink discard{OutputSinkType::Discard};
+    REQUIRE(write(mesh, format, discard));
+    REQUIRE(discard.close());
+    CHECK(discard.size() == expected.size());
+  }
+}
+
+// Verifies that all writers write the vertex attributes of a mesh.
+TEST_CASE("Test writer libraries for attributed meshes")
+{
+  const Format format = GENERATE(Format::Ascii, Format::BinaryLittleEndian);
+
+  const AttributedTriangleMesh mesh = createAttributedMesh(MeshShape::Sphere, 1000);
+
+  for (const WriterBackend &backend : writerBackends())
+  {
+    INFO(backend.libraryName + " (" + formatToString(format) + ')');
+
+    OutputSink disk{OutputSinkType::Disk};
+    REQUIRE(backend.writeAttributed(mesh, format, disk));
+    REQUIRE(disk.close());
+
+    const std::optional<AttributedTriangleMesh> maybeMesh = parseAttributedRPly(disk.filename());
+    REQUIRE(maybeMesh.has_value());
+    CHECK(mesh == *maybeMesh);
+  }
+}
+
+// Verifies that all writers able to write a structure of arrays write the same
+// mesh as for an array of structures.
+TEST_CASE("Test writer libraries for structure of arrays meshes")
+{
+  const Format format = GENERATE(Format::Ascii, Format::BinaryLittleEndian);
+
+  const TriangleMesh mesh = createMesh(1000);
+
+  for (const WriterBackend &backend : writerBackends())
+  {
+    if (!backend.writeSoa) { continue; }
+
+    INFO(backend.libraryName + " (" + formatToString(format) + ')');
+
+    OutputSink disk{OutputSinkType::Disk};
+    REQUIRE(backend.writeSoa(toStructureOfArrays(mesh), format, disk));
+    REQUIRE(disk.close());
+
+    const std::optional<TriangleMesh> maybeMesh = parseRPly(disk.filename());
+    REQUIRE(maybeMesh.has_value());
+    CHECK(mesh == *maybeMesh);
+  }
+}
+
 int main(int argc, char *argv[]) { return Catch::Session().run(argc, argv); }
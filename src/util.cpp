@@ -1,28 +1,1334 @@
 #include "util.h"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
 #include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
-TriangleMesh createMesh(std::int32_t numTriangles)
+namespace {
+constexpr float pi = 3.14159265358979f;
+
+// Rounds the given value to six significant digits; see `createMesh()`.
+float roundCoordinate(float value)
 {
-  Triangles triangles;
+  char buffer[32];
+  const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6);
+  std::from_chars(buffer, end, value);
+  return value;
+}
+
+Vertex makeVertex(float x, float y, float z)
+{
+  return Vertex{roundCoordinate(x), roundCoordinate(y), roundCoordinate(z)};
+}
+
+// Determines the number of columns and rows of quads required for a grid
+// containing at least the given number of triangles, keeping the grid roughly
+// square.
+std::pair<std::int64_t, std::int64_t> gridSize(std::int64_t numTriangles)
+{
+  const std::int64_t numQuads = (numTriangles + 1) / 2;
+  const std::int64_t columns = std::max<std::int64_t>(1, std::ceil(std::sqrt(double(numQuads))));
+  const std::int64_t rows = std::max<std::int64_t>(1, (numQuads + columns - 1) / columns);
+  return {columns, rows};
+}
+
+// Returns the triangle with the given index of a grid of quads with the given
+// number of columns, with its vertices stored in row major order. Quads are
+// triangulated row by row, and split into two triangles each.
+BasicTriangle<std::int64_t> gridTriangle(std::int64_t columns, std::int64_t index)
+{
+  const std::int64_t stride = columns + 1;
+  const std::int64_t quad = index / 2;
+  const std::int64_t v = quad / columns * stride + quad % columns;
+  if (index % 2 == 0) { return {v, v + 1, v + stride}; }
+  return {v + 1, v + stride + 1, v + stride};
+}
+
+// Returns the vertex of a UV sphere with the given number of stacks and slices
+// at the given stack and slice, where stack zero is the north pole.
+Vertex sphereVertex(std::int64_t stack, std::int64_t slice, std::int64_t stacks, std::int64_t slices)
+{
+  const float theta = pi * stack / stacks;
+  const float phi = 2 * pi * slice / slices;
+  return makeVertex(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+}
+
+// Returns the vertex of a height field over a regular grid of quads at the given
+// column and row, with normally distributed noise on its height.
+Vertex noisyGridVertex(
+    std::int64_t column,
+    std::int64_t row,
+    float spacing,
+    std::normal_distribution<float> &noise,
+    std::mt19937 &rng)
+{
+  const float x = column * spacing;
+  const float y = row * spacing;
+  return makeVertex(x, y, 0.1f * std::sin(4 * pi * x) * std::cos(4 * pi * y) + noise(rng));
+}
+
+// Generates the vertices of a height field over a regular grid of quads, with
+// normally distributed noise on the height of each vertex.
+Vertices createNoisyGridVertices(std::int32_t columns, std::int32_t rows, std::mt19937 &rng)
+{
+  const float spacing = 1.0f / std::max(columns, rows);
+
+  std::normal_distribution<float> noise{0.0f, 0.25f * spacing};
 
   Vertices vertices;
-  vertices.reserve(2 + numTriangles);
-  for (std::size_t i = 0; i < 2 + numTriangles; ++i)
+  vertices.reserve(std::size_t(columns + 1) * (rows + 1));
+  for (std::int32_t row = 0; row <= rows; ++row)
+  {
+    for (std::int32_t column = 0; column <= columns; ++column)
+    {
+      vertices.push_back(noisyGridVertex(column, row, spacing, noise, rng));
+    }
+  }
+
+  return vertices;
+}
+
+// Generates the mesh of the given stream in memory.
+template<typename Mesh>
+Mesh collectMesh(MeshStream stream)
+{
+  using Index = typename Mesh::Index;
+
+  Mesh mesh;
+  mesh.vertices.reserve(stream.numVertices());
+  for (std::int64_t i = 0; i < stream.numVertices(); ++i) { mesh.vertices.push_back(stream.nextVertex()); }
+  mesh.triangles.reserve(stream.numTriangles());
+  for (std::int64_t i = 0; i < stream.numTriangles(); ++i)
+  {
+    const BasicTriangle<std::int64_t> t = stream.triangle(i);
+    mesh.triangles.push_back({Index(t.a), Index(t.b), Index(t.c)});
+  }
+
+  return mesh;
+}
+
+// Generates a bumpy closed-ish surface sampled at jittered positions, similar to
+// the output of a 3D scanner. Both the vertex order and the triangle order are
+// shuffled, so that consecutive triangles reference vertices scattered all over
+// the vertex list, as is the case for reconstructed scans.
+template<typename Mesh>
+Mesh createScannedSurfaceMesh(std::int64_t numTriangles, std::mt19937 &rng)
+{
+  using Index = typename Mesh::Index;
+
+  const auto [columns, rows] = gridSize(numTriangles);
+
+  std::uniform_real_distribution<float> jitter{-0.3f, 0.3f};
+  std::normal_distribution<float> noise{0.0f, 0.002f};
+
+  Vertices vertices;
+  vertices.reserve(std::size_t(columns + 1) * (rows + 1));
+  for (std::int64_t row = 0; row <= rows; ++row)
+  {
+    for (std::int64_t column = 0; column <= columns; ++column)
+    {
+      const float u = 2 * pi * (column + jitter(rng)) / columns;
+      const float v = pi * (0.05f + 0.9f * (row + jitter(rng)) / rows);
+      const float r = 1.0f + 0.05f * std::sin(7 * u) * std::sin(5 * v) + noise(rng);
+      vertices.push_back(
+          makeVertex(r * std::sin(v) * std::cos(u), r * std::sin(v) * std::sin(u), r * std::cos(v)));
+    }
+  }
+
+  std::vector<Index> permutation(vertices.size());
+  std::iota(permutation.begin(), permutation.end(), Index{0});
+  std::shuffle(permutation.begin(), permutation.end(), rng);
+
+  Mesh mesh;
+  mesh.vertices.resize(vertices.size());
+  for (std::size_t i = 0; i < vertices.size(); ++i) { mesh.vertices[permutation[i]] = vertices[i]; }
+  mesh.triangles.reserve(numTriangles);
+  for (std::int64_t i = 0; i < numTriangles; ++i)
+  {
+    const BasicTriangle<std::int64_t> t = gridTriangle(columns, i);
+    mesh.triangles.push_back({permutation[t.a], permutation[t.b], permutation[t.c]});
+  }
+  std::shuffle(mesh.triangles.begin(), mesh.triangles.end(), rng);
+
+  return mesh;
+}
+
+template<typename T>
+T byteSwap(T value)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  std::reverse(bytes, bytes + sizeof(T));
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+template<typename T>
+void writeBinary(std::FILE *fp, T value, bool swapBytes)
+{
+  if (swapBytes) value = byteSwap(value);
+  std::fwrite(&value, sizeof(T), 1, fp);
+}
+
+// Appends the given value to a line that ends at `end`, followed by a space,
+// and advances `p` past it. Returns false, leaving `p` as is, in case the value
+// and the space do not fit.
+template<typename T>
+bool appendAscii(char *&p, char *end, T value)
+{
+  const std::to_chars_result result = std::to_chars(p, end - 1, value);
+  if (result.ec != std::errc{}) { return false; }
+  p = result.ptr;
+  *p++ = ' ';
+  return true;
+}
+
+// Writes the given values as a single line of an ASCII PLY file. Returns false
+// in case the line does not fit the buffer, without writing anything.
+template<typename... Ts>
+bool writeAsciiLine(std::FILE *fp, Ts... values)
+{
+  static_assert(sizeof...(Ts) > 0);
+
+  char line[256];
+  char *p = line;
+  if (!(appendAscii(p, line + sizeof(line), values) && ...)) { return false; }
+  p[-1] = '\n';
+  std::fwrite(line, 1, p - line, fp);
+  return true;
+}
+
+// Returns the name of the PLY type that stores values of the given type.
+template<typename T>
+const char *plyTypeName()
+{
+  if constexpr (std::is_same_v<T, float>) { return "float"; }
+  else if constexpr (std::is_same_v<T, double>) { return "double"; }
+  else if constexpr (std::is_same_v<T, std::int32_t>) { return "int"; }
+  else if constexpr (std::is_same_v<T, std::uint32_t>) { return "uint"; }
+  else
+  {
+    static_assert(std::is_same_v<T, std::uint16_t>);
+    return "ushort";
+  }
+}
+
+// Type vertex indices of the given type are stored as; since PLY has no 64-bit
+// integer type, 64-bit indices are stored as `uint`.
+template<typename Index>
+using StoredIndex = std::conditional_t<sizeof(Index) == 8, std::uint32_t, Index>;
+
+// Number of vertices that 64-bit indices are able to address once stored.
+constexpr std::int64_t maxStoredVertices = std::int64_t(std::numeric_limits<std::uint32_t>::max()) + 1;
+
+template<typename Coordinate>
+auto vertexValues(const BasicVertex<Coordinate> &v)
+{
+  return std::make_tuple(v.x, v.y, v.z);
+}
+
+auto vertexValues(const AttributedVertex &v)
+{
+  return std::make_tuple(v.x, v.y, v.z, v.nx, v.ny, v.nz, v.red, v.green, v.blue, v.alpha, v.u, v.v);
+}
+
+// Writes the given vertex indices of a face as a single line of an ASCII PLY
+// file, preceded by the number of indices, which is at most 255. Returns false
+// in case the line does not fit the buffer, without writing anything.
+template<typename Index>
+bool writeAsciiFace(std::FILE *fp, const Index *indices, std::int32_t size)
+{
+  char line[12 * 256];
+  char *p = line;
+  if (!appendAscii(p, line + sizeof(line), size)) { return false; }
+  for (std::int32_t i = 0; i < size; ++i)
   {
-    vertices.push_back(Vertex{i / 2.0f, (i + 1) / 2.0f, (i + 2) / 2.0f});
+    if (!appendAscii(p, line + sizeof(line), indices[i])) { return false; }
   }
+  p[-1] = '\n';
+  std::fwrite(line, 1, p - line, fp);
+  return true;
+}
+
+template<typename Mesh>
+std::size_t numVertices(const Mesh &mesh)
+{
+  return mesh.vertices.size();
+}
+
+std::size_t numVertices(const MeshStream &stream)
+{
+  return stream.numVertices();
+}
+
+template<typename Mesh>
+std::size_t numFaces(const Mesh &mesh)
+{
+  return mesh.triangles.size();
+}
+
+std::size_t numFaces(const PolygonMesh &mesh)
+{
+  return mesh.numFaces();
+}
+
+std::size_t numFaces(const MeshStream &stream)
+{
+  return stream.numTriangles();
+}
+
+template<typename Mesh>
+const char *indexTypeName(const Mesh &mesh)
+{
+  return plyTypeName<StoredIndex<decltype(mesh.triangles[0].a)>>();
+}
+
+const char *indexTypeName(const PolygonMesh &)
+{
+  return plyTypeName<std::int32_t>();
+}
+
+const char *indexTypeName(const MeshStream &)
+{
+  return plyTypeName<StoredIndex<std::int64_t>>();
+}
+
+// Calls `fn` for every vertex of the given mesh.
+template<typename Mesh, typename Fn>
+void forEachVertex(const Mesh &mesh, Fn fn)
+{
+  for (const auto &v : mesh.vertices) { fn(v); }
+}
+
+template<typename Fn>
+void forEachVertex(const MeshStream &stream, Fn fn)
+{
+  MeshStream vertices = stream;
+  for (std::int64_t i = 0; i < vertices.numVertices(); ++i) { fn(vertices.nextVertex()); }
+}
+
+// Calls `fn` with the vertex indices and the number of vertices of every face of
+// the given mesh.
+template<typename Mesh, typename Fn>
+void forEachFace(const Mesh &mesh, Fn fn)
+{
+  for (const auto &t : mesh.triangles)
+  {
+    using Index = StoredIndex<decltype(t.a)>;
+    const Index indices[]{Index(t.a), Index(t.b), Index(t.c)};
+    fn(indices, 3);
+  }
+}
+
+template<typename Fn>
+void forEachFace(const MeshStream &stream, Fn fn)
+{
+  for (std::int64_t i = 0; i < stream.numTriangles(); ++i)
+  {
+    const BasicTriangle<std::int64_t> t = stream.triangle(i);
+    using Index = StoredIndex<std::int64_t>;
+    const Index indices[]{Index(t.a), Index(t.b), Index(t.c)};
+    fn(indices, 3);
+  }
+}
+
+template<typename Fn>
+void forEachFace(const PolygonMesh &mesh, Fn fn)
+{
+  for (std::size_t i = 0; i < mesh.numFaces(); ++i)
+  {
+    fn(mesh.indices.data() + mesh.offsets[i], mesh.offsets[i + 1] - mesh.offsets[i]);
+  }
+}
+
+// Writes the given mesh to a PLY file, where `vertexProperties` declares the
+// vertex properties in the order in which `vertexValues()` returns them.
+template<typename Mesh>
+bool writePly(
+    const Mesh &mesh,
+    Format format,
+    const std::filesystem::path &filename,
+    const char *vertexProperties)
+{
+  std::unique_ptr<std::FILE, decltype(&std::fclose)> fp{std::fopen(filename.c_str(), "wb"), std::fclose};
+  if (!fp) { return false; }
+
+  const char *formatName = "ascii";
+  if (format == Format::BinaryLittleEndian) { formatName = "binary_little_endian"; }
+  if (format == Format::BinaryBigEndian) { formatName = "binary_big_endian"; }
+  std::fprintf(
+      fp.get(),
+      "ply\n"
+      "format %s 1.0\n"
+      "comment generated by PLYbench\n"
+      "element vertex %zu\n"
+      "%s"
+      "element face %zu\n"
+      "property list uchar %s vertex_indices\n"
+      "end_header\n",
+      formatName, numVertices(mesh), vertexProperties, numFaces(mesh), indexTypeName(mesh));
+
+  bool valid = true;
+  if (format == Format::Ascii)
+  {
+    forEachVertex(mesh, [&](const auto &v) {
+      std::apply(
+          [&](auto... values) { valid = valid && writeAsciiLine(fp.get(), values...); }, vertexValues(v));
+    });
+
+    forEachFace(mesh, [&](const auto *indices, std::int32_t size) {
+      valid = valid && writeAsciiFace(fp.get(), indices, size);
+    });
+  }
+  else
+  {
+    const bool hostIsBigEndian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+    const bool swapBytes = (format == Format::BinaryBigEndian) != hostIsBigEndian;
+    forEachVertex(mesh, [&](const auto &v) {
+      std::apply([&](auto... values) { (writeBinary(fp.get(), values, swapBytes), ...); }, vertexValues(v));
+    });
+
+    forEachFace(mesh, [&](const auto *indices, std::int32_t size) {
+      writeBinary(fp.get(), std::uint8_t(size), swapBytes);
+      for (std::int32_t i = 0; i < size; ++i) { writeBinary(fp.get(), indices[i], swapBytes); }
+    });
+  }
+
+  return valid && !std::ferror(fp.get()) && std::fclose(fp.release()) == 0;
+}
+
+std::string formatToFilenameSuffix(Format format)
+{
+  switch (format)
+  {
+    case Format::Ascii:
+      return "ascii";
+    case Format::BinaryBigEndian:
+      return "binary_be";
+    case Format::BinaryLittleEndian:
+      return "binary_le";
+  }
+
+  return {};
+}
+
+// Returns the name of a format as used in the name of a model, like
+// `binary little endian`.
+std::string modelFormatName(Format format)
+{
+  std::string formatName = formatToString(format);
+  if (format != Format::Ascii) { formatName[0] = std::tolower(formatName[0]); }
+  return formatName;
+}
+
+// Normalizes the name of a PLY property type, see `PlyProperty`.
+std::string normalizePlyType(const std::string &type)
+{
+  static const std::pair<const char *, const char *> aliases[] = {
+      {"int8", "char"},   {"uint8", "uchar"},   {"int16", "short"},   {"uint16", "ushort"},
+      {"int32", "int"},   {"uint32", "uint"},   {"float32", "float"}, {"float64", "double"}};
+  for (const auto &[alias, name] : aliases)
+  {
+    if (type == alias) { return name; }
+  }
+  return type;
+}
+
+// Formats a triangle count in a compact human readable form, like 100K or 10M.
+std::string triangleCountToString(std::int64_t numTriangles)
+{
+  if (numTriangles >= 1000000 && numTriangles % 1000000 == 0)
+  {
+    return std::to_string(numTriangles / 1000000) + 'M';
+  }
+  if (numTriangles >= 1000 && numTriangles % 1000 == 0) { return std::to_string(numTriangles / 1000) + 'K'; }
+  return std::to_string(numTriangles);
+}
+
+// Returns the base filename of a generated model with the given name, size and
+// seed, like `noisy_grid_1000_s0`.
+std::string modelBasename(const std::string &name, std::int64_t size, std::uint32_t seed)
+{
+  std::string basename = name;
+  std::transform(basename.begin(), basename.end(), basename.begin(), [](char c) {
+    return c == ' ' ? '_' : std::tolower(c);
+  });
+  return basename + '_' + std::to_string(size) + "_s" + std::to_string(seed);
+}
+
+// Writes the given mesh to the file of a generated model. The mesh is written to
+// a temporary file first, so that an interrupted run never leaves a truncated
+// model behind; the temporary file is removed again in case writing fails.
+template<typename Mesh>
+bool writeModel(const Mesh &mesh, Format format, const std::filesystem::path &filename)
+{
+  std::filesystem::path partialFilename = filename;
+  partialFilename += ".partial";
+  std::error_code ec;
+  if (!writeMesh(mesh, format, partialFilename))
+  {
+    std::filesystem::remove(partialFilename, ec);
+    return false;
+  }
+
+  std::filesystem::rename(partialFilename, filename, ec);
+  if (ec)
+  {
+    std::error_code removeError;
+    std::filesystem::remove(partialFilename, removeError);
+    return false;
+  }
+  return true;
+}
+}
+
+std::string meshShapeToString(MeshShape shape)
+{
+  switch (shape)
+  {
+    case MeshShape::Strip:
+      return "Strip";
+    case MeshShape::Sphere:
+      return "Sphere";
+    case MeshShape::NoisyGrid:
+      return "Noisy grid";
+    case MeshShape::ScannedSurface:
+      return "Scanned surface";
+  }
+
+  return {};
+}
+
+TriangleMesh createMesh(std::int64_t numTriangles)
+{
+  return createMesh(MeshShape::Strip, numTriangles);
+}
+
+template<typename Mesh>
+Mesh createMesh(MeshShape shape, std::int64_t numTriangles, std::uint32_t seed)
+{
+  if (numTriangles <= 0) { return Mesh{}; }
+
+  if (shape == MeshShape::ScannedSurface)
+  {
+    std::mt19937 rng{seed};
+    return createScannedSurfaceMesh<Mesh>(numTriangles, rng);
+  }
+
+  return collectMesh<Mesh>(MeshStream{shape, numTriangles, seed});
+}
+
+template TriangleMesh createMesh<TriangleMesh>(MeshShape, std::int64_t, std::uint32_t);
+template Int64TriangleMesh createMesh<Int64TriangleMesh>(MeshShape, std::int64_t, std::uint32_t);
+
+MeshStream::MeshStream(MeshShape shape, std::int64_t numTriangles, std::uint32_t seed)
+    : shape_{shape}, rng_{seed}
+{
+  if (numTriangles <= 0 || !supports(shape)) { return; }
+
+  numTriangles_ = numTriangles;
+  switch (shape)
+  {
+    case MeshShape::Strip:
+      numVertices_ = 2 + numTriangles;
+      break;
+    case MeshShape::Sphere:
+      // A UV sphere of slices and stacks, where the top and bottom stacks are
+      // triangle fans around the poles.
+      columns_ = std::max<std::int64_t>(3, std::llround(std::sqrt(double(numTriangles))));
+      rows_ = std::max<std::int64_t>(2, (numTriangles + 2 * columns_ - 1) / (2 * columns_) + 1);
+      numVertices_ = 2 + (rows_ - 1) * columns_;
+      break;
+    case MeshShape::NoisyGrid:
+    {
+      std::tie(columns_, rows_) = gridSize(numTriangles);
+      numVertices_ = (columns_ + 1) * (rows_ + 1);
+      const float spacing = 1.0f / std::max(columns_, rows_);
+      noise_ = std::normal_distribution<float>{0.0f, 0.25f * spacing};
+      break;
+    }
+    case MeshShape::ScannedSurface:
+      break;
+  }
+}
+
+Vertex MeshStream::nextVertex()
+{
+  const std::int64_t i = vertex_++;
+  switch (shape_)
+  {
+    case MeshShape::Strip:
+      return Vertex{i / 2.0f, (i + 1) / 2.0f, (i + 2) / 2.0f};
+    case MeshShape::Sphere:
+      if (i == 0) { return makeVertex(0, 0, 1); }
+      if (i == numVertices_ - 1) { return makeVertex(0, 0, -1); }
+      return sphereVertex(1 + (i - 1) / columns_, (i - 1) % columns_, rows_, columns_);
+    case MeshShape::NoisyGrid:
+      return noisyGridVertex(
+          i % (columns_ + 1), i / (columns_ + 1), 1.0f / std::max(columns_, rows_), noise_, rng_);
+    case MeshShape::ScannedSurface:
+      break;
+  }
+
+  return Vertex{};
+}
+
+BasicTriangle<std::int64_t> MeshStream::triangle(std::int64_t index) const
+{
+  switch (shape_)
+  {
+    case MeshShape::Strip:
+      return {index, index + 1, index + 2};
+    case MeshShape::Sphere:
+    {
+      const std::int64_t slices = columns_;
+      const std::int64_t stacks = rows_;
+      auto ring = [slices](std::int64_t stack, std::int64_t slice) {
+        return 1 + (stack - 1) * slices + slice % slices;
+      };
+
+      // The fan around the north pole, the stacks in between, and the fan around
+      // the south pole.
+      if (index < slices) { return {0, ring(1, index), ring(1, index + 1)}; }
+      index -= slices;
+      if (index < 2 * slices * (stacks - 2))
+      {
+        const std::int64_t stack = 1 + index / (2 * slices);
+        const std::int64_t slice = index % (2 * slices) / 2;
+        if (index % 2 == 0) { return {ring(stack, slice), ring(stack + 1, slice), ring(stack, slice + 1)}; }
+        return {ring(stack, slice + 1), ring(stack + 1, slice), ring(stack + 1, slice + 1)};
+      }
+      const std::int64_t slice = index - 2 * slices * (stacks - 2);
+      return {ring(stacks - 1, slice), numVertices_ - 1, ring(stacks - 1, slice + 1)};
+    }
+    case MeshShape::NoisyGrid:
+      return gridTriangle(columns_, index);
+    case MeshShape::ScannedSurface:
+      break;
+  }
+
+  return {};
+}
+
+template<typename Coordinate, typename Index>
+bool matchesGeneratedMesh(const BasicTriangleMesh<Coordinate, Index> &mesh, MeshStream stream)
+{
+  if (std::int64_t(mesh.vertices.size()) != stream.numVertices()) { return false; }
+  if (std::int64_t(mesh.triangles.size()) != stream.numTriangles()) { return false; }
+
+  for (const BasicVertex<Coordinate> &v : mesh.vertices)
+  {
+    if (Vertex{float(v.x), float(v.y), float(v.z)} != stream.nextVertex()) { return false; }
+  }
+  for (std::int64_t i = 0; i < stream.numTriangles(); ++i)
+  {
+    const BasicTriangle<Index> &t = mesh.triangles[i];
+    if (BasicTriangle<std::int64_t>{t.a, t.b, t.c} != stream.triangle(i)) { return false; }
+  }
+
+  return true;
+}
+
+template bool matchesGeneratedMesh(const TriangleMesh &, MeshStream);
+template bool matchesGeneratedMesh(const DoubleTriangleMesh &, MeshStream);
+template bool matchesGeneratedMesh(const UInt32TriangleMesh &, MeshStream);
+template bool matchesGeneratedMesh(const UInt16TriangleMesh &, MeshStream);
+template bool matchesGeneratedMesh(const Int64TriangleMesh &, MeshStream);
+
+AttributedTriangleMesh createAttributedMesh(MeshShape shape, std::int64_t numTriangles, std::uint32_t seed)
+{
+  TriangleMesh mesh = createMesh(shape, numTriangles, seed);
+
+  // Accumulates the face normals of all triangles around a vertex; the length of
+  // a face normal is twice the area of the triangle, so that larger triangles
+  // contribute more.
+  std::vector<std::array<float, 3>> normals(mesh.vertices.size(), {0, 0, 0});
+  for (const Triangle &t : mesh.triangles)
+  {
+    const Vertex &a = mesh.vertices[t.a];
+    const Vertex &b = mesh.vertices[t.b];
+    const Vertex &c = mesh.vertices[t.c];
+    const float ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+    const float vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+    for (std::int32_t i : {t.a, t.b, t.c})
+    {
+      normals[i][0] += uy * vz - uz * vy;
+      normals[i][1] += uz * vx - ux * vz;
+      normals[i][2] += ux * vy - uy * vx;
+    }
+  }
+
+  float minX = std::numeric_limits<float>::max(), maxX = std::numeric_limits<float>::lowest();
+  float minY = minX, maxY = maxX;
+  for (const Vertex &v : mesh.vertices)
+  {
+    minX = std::min(minX, v.x);
+    maxX = std::max(maxX, v.x);
+    minY = std::min(minY, v.y);
+    maxY = std::max(maxY, v.y);
+  }
+  auto textureCoordinate = [](float value, float min, float max) {
+    return max > min ? roundCoordinate((value - min) / (max - min)) : 0.0f;
+  };
+  auto colorComponent = [](float value) { return std::uint8_t(std::lround((value + 1) * 127.5f)); };
+
+  AttributedVertices vertices;
+  vertices.reserve(mesh.vertices.size());
+  for (std::size_t i = 0; i < mesh.vertices.size(); ++i)
+  {
+    const Vertex &v = mesh.vertices[i];
+
+    // Degenerate triangles, like the ones in a strip, do not define a normal.
+    auto [nx, ny, nz] = normals[i];
+    const float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+    if (length > 0)
+    {
+      nx = roundCoordinate(nx / length);
+      ny = roundCoordinate(ny / length);
+      nz = roundCoordinate(nz / length);
+    }
+    else { nx = 0, ny = 0, nz = 1; }
+
+    vertices.push_back(AttributedVertex{
+        v.x, v.y, v.z, nx, ny, nz, colorComponent(nx), colorComponent(ny), colorComponent(nz), 255,
+        textureCoordinate(v.x, minX, maxX), textureCoordinate(v.y, minY, maxY)});
+  }
+
+  return AttributedTriangleMesh{std::move(mesh.triangles), std::move(vertices)};
+}
+
+std::string meshPrecisionToString(MeshPrecision precision)
+{
+  switch (precision)
+  {
+    case MeshPrecision::Float:
+      return {};
+    case MeshPrecision::Double:
+      return "double coordinates";
+    case MeshPrecision::UInt32:
+      return "uint indices";
+    case MeshPrecision::UInt16:
+      return "ushort indices";
+    case MeshPrecision::Int64:
+      return "int64 indices";
+  }
+
+  return {};
+}
+
+std::size_t maxMeshVertices(MeshPrecision precision)
+{
+  return visitMeshPrecision(precision, [](auto mesh) {
+    return std::size_t(std::numeric_limits<typename decltype(mesh)::Index>::max()) + 1;
+  });
+}
+
+bool isNarrowingConversion(MeshPrecision stored, MeshPrecision precision)
+{
+  return visitMeshPrecision(stored, [precision](auto storedMesh) {
+    return visitMeshPrecision(precision, [](auto mesh) {
+      using StoredMesh = decltype(storedMesh);
+      using Mesh = decltype(mesh);
+      using StoredIndex = typename StoredMesh::Index;
+      using Index = typename Mesh::Index;
+      return sizeof(typename Mesh::Coordinate) < sizeof(typename StoredMesh::Coordinate) ||
+             sizeof(Index) < sizeof(StoredIndex) ||
+             (std::is_signed_v<StoredIndex> && std::is_unsigned_v<Index>);
+    });
+  });
+}
+
+SoaTriangleMesh toStructureOfArrays(const TriangleMesh &mesh)
+{
+  SoaTriangleMesh soaMesh{mesh.triangles, {}};
+  soaMesh.vertices.reserve(mesh.vertices.size());
+  for (const Vertex &v : mesh.vertices)
+  {
+    soaMesh.vertices.x.push_back(v.x);
+    soaMesh.vertices.y.push_back(v.y);
+    soaMesh.vertices.z.push_back(v.z);
+  }
+  return soaMesh;
+}
+
+TriangleMesh toArrayOfStructures(const SoaTriangleMesh &mesh)
+{
+  TriangleMesh aosMesh{mesh.triangles, {}};
+  aosMesh.vertices.reserve(mesh.vertices.size());
+  for (std::size_t i = 0; i < mesh.vertices.size(); ++i) { aosMesh.vertices.push_back(mesh.vertices[i]); }
+  return aosMesh;
+}
+
+std::string polygonMixToString(PolygonMix mix)
+{
+  switch (mix)
+  {
+    case PolygonMix::QuadDominant:
+      return "Quad dominant";
+    case PolygonMix::Mixed:
+      return "Mixed polygons";
+  }
+
+  return {};
+}
+
+PolygonMesh createPolygonMesh(PolygonMix mix, std::int32_t numFaces, std::uint32_t seed)
+{
+  if (numFaces <= 0) { return PolygonMesh{}; }
+
+  std::mt19937 rng{seed};
+  std::uniform_real_distribution<float> choice{0.0f, 1.0f};
+
+  PolygonMesh mesh;
+  mesh.offsets.reserve(std::size_t(numFaces) + 1);
+  mesh.indices.reserve(4 * std::size_t(numFaces));
+  auto add = [&mesh](std::initializer_list<std::int32_t> face) {
+    mesh.indices.insert(mesh.indices.end(), face);
+    mesh.offsets.push_back(std::int32_t(mesh.indices.size()));
+  };
+
+  // Every cell of the grid holds about one face. Cells are filled row by row,
+  // where a cell is either a quad or split into two triangles, or, for a mixed
+  // mesh, two neighboring cells are merged into a hexagon, or into a pentagon and
+  // a triangle.
+  const std::int32_t columns = std::max<std::int32_t>(1, std::ceil(std::sqrt(double(numFaces))));
+  const std::int32_t stride = columns + 1;
+  std::int32_t rows = 0;
+  for (; std::int32_t(mesh.numFaces()) < numFaces; ++rows)
+  {
+    std::int32_t column = 0;
+    while (column < columns && std::int32_t(mesh.numFaces()) < numFaces)
+    {
+      const std::int32_t v = rows * stride + column;
+      const bool twoFacesLeft = numFaces - std::int32_t(mesh.numFaces()) >= 2;
+      const float r = choice(rng);
+      if (r < (mix == PolygonMix::QuadDominant ? 0.1f : 0.3f) && twoFacesLeft)
+      {
+        add({v, v + 1, v + stride});
+        add({v + 1, v + stride + 1, v + stride});
+        column += 1;
+      }
+      else if (mix == PolygonMix::Mixed && r >= 0.65f && column + 1 < columns)
+      {
+        if (r < 0.85f && twoFacesLeft)
+        {
+          add({v + 1, v + 2, v + stride + 1, v + stride, v});
+          add({v + 2, v + stride + 2, v + stride + 1});
+        }
+        else { add({v + 1, v + 2, v + stride + 2, v + stride + 1, v + stride, v}); }
+        column += 2;
+      }
+      else
+      {
+        add({v, v + 1, v + stride + 1, v + stride});
+        column += 1;
+      }
+    }
+  }
+
+  mesh.vertices = createNoisyGridVertices(columns, rows, rng);
+  return mesh;
+}
+
+std::size_t countTriangles(const PolygonMesh &mesh)
+{
+  std::size_t numTriangles = 0;
+  for (std::size_t i = 0; i < mesh.numFaces(); ++i)
+  {
+    numTriangles += std::max(0, mesh.offsets[i + 1] - mesh.offsets[i] - 2);
+  }
+  return numTriangles;
+}
+
+TriangleMesh triangulate(PolygonMesh mesh)
+{
+  Triangles triangles;
+  triangles.reserve(countTriangles(mesh));
+  for (std::size_t i = 0; i < mesh.numFaces(); ++i)
+  {
+    const std::int32_t *face = mesh.indices.data() + mesh.offsets[i];
+    const std::int32_t size = mesh.offsets[i + 1] - mesh.offsets[i];
+    for (std::int32_t j = 2; j < size; ++j) { triangles.push_back(Triangle{face[0], face[j - 1], face[j]}); }
+  }
+
+  return TriangleMesh{std::move(triangles), std::move(mesh.vertices)};
+}
+
+template<typename Coordinate, typename Index>
+bool writeMesh(
+    const BasicTriangleMesh<Coordinate, Index> &mesh,
+    Format format,
+    const std::filesystem::path &filename)
+{
+  if (sizeof(Index) == 8 && std::int64_t(mesh.vertices.size()) > maxStoredVertices) { return false; }
+
+  const std::string type = plyTypeName<Coordinate>();
+  const std::string vertexProperties =
+      "property " + type + " x\n" + "property " + type + " y\n" + "property " + type + " z\n";
+  return writePly(mesh, format, filename, vertexProperties.c_str());
+}
+
+template bool writeMesh(const TriangleMesh &, Format, const std::filesystem::path &);
+template bool writeMesh(const DoubleTriangleMesh &, Format, const std::filesystem::path &);
+template bool writeMesh(const UInt32TriangleMesh &, Format, const std::filesystem::path &);
+template bool writeMesh(const UInt16TriangleMesh &, Format, const std::filesystem::path &);
+template bool writeMesh(const Int64TriangleMesh &, Format, const std::filesystem::path &);
+
+bool writeMesh(const AttributedTriangleMesh &mesh, Format format, const std::filesystem::path &filename)
+{
+  return writePly(
+      mesh, format, filename,
+      "property float x\n"
+      "property float y\n"
+      "property float z\n"
+      "property float nx\n"
+      "property float ny\n"
+      "property float nz\n"
+      "property uchar red\n"
+      "property uchar green\n"
+      "property uchar blue\n"
+      "property uchar alpha\n"
+      "property float u\n"
+      "property float v\n");
+}
+
+bool writeMesh(const PolygonMesh &mesh, Format format, const std::filesystem::path &filename)
+{
+  return writePly(
+      mesh, format, filename,
+      "property float x\n"
+      "property float y\n"
+      "property float z\n");
+}
+
+bool writeMesh(const MeshStream &stream, Format format, const std::filesystem::path &filename)
+{
+  if (stream.numVertices() > maxStoredVertices) { return false; }
+
+  return writePly(
+      stream, format, filename,
+      "property float x\n"
+      "property float y\n"
+      "property float z\n");
+}
+
+std::vector<GeneratedModel> corpusModels(
+    const std::filesystem::path &directory,
+    std::int64_t numTriangles,
+    std::uint32_t seed,
+    const std::vector<MeshShape> &shapes,
+    bool attributed,
+    MeshPrecision precision)
+{
+  std::vector<GeneratedModel> models;
+
+  if (attributed) { precision = MeshPrecision::Float; }
+
+  for (MeshShape shape : shapes)
+  {
+    std::string shapeName = meshShapeToString(shape);
+    if (attributed) { shapeName += " with attributes"; }
+    if (precision != MeshPrecision::Float) { shapeName += " with " + meshPrecisionToString(precision); }
+
+    const std::string basename = modelBasename(shapeName, numTriangles, seed);
+
+    for (Format format : {Format::Ascii, Format::BinaryLittleEndian, Format::BinaryBigEndian})
+    {
+      models.push_back(GeneratedModel{
+          shapeName + ' ' + triangleCountToString(numTriangles) + " (" + modelFormatName(format) + ')',
+          directory / (basename + '_' + formatToFilenameSuffix(format) + ".ply"),
+          shape,
+          format,
+          numTriangles,
+          seed,
+          attributed,
+          precision});
+    }
+  }
+
+  return models;
+}
+
+std::vector<GeneratedModel> generateCorpus(
+    const std::filesystem::path &directory,
+    std::int64_t numTriangles,
+    std::uint32_t seed,
+    const std::vector<MeshShape> &shapes,
+    bool attributed,
+    MeshPrecision precision)
+{
+  std::vector<GeneratedModel> models;
+
+  // Every shape has more than half as many vertices as triangles, which rules
+  // out most models that are too large for their index type without generating
+  // their mesh.
+  const std::size_t maxVertices = maxMeshVertices(precision);
+  if (!attributed && std::size_t(numTriangles) / 2 >= maxVertices) { return models; }
+
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec) { return models; }
+
+  // Only generate a mesh in case at least one of its model files is missing,
+  // and generate it at most once for all formats.
+  std::optional<TriangleMesh> mesh;
+  std::optional<AttributedTriangleMesh> attributedMesh;
+  std::optional<MeshShape> meshShape;
+  for (GeneratedModel &model : corpusModels(directory, numTriangles, seed, shapes, attributed, precision))
+  {
+    // Models with 64-bit indices are generated one at a time, since their mesh
+    // may be too large to keep in memory.
+    if (model.precision == MeshPrecision::Int64)
+    {
+      if (generateModel(model)) { models.push_back(std::move(model)); }
+      continue;
+    }
+
+    if (!std::filesystem::exists(model.filename))
+    {
+      if (meshShape != model.shape)
+      {
+        if (attributed) { attributedMesh = model.attributedMesh(); }
+        else { mesh = model.mesh(); }
+        meshShape = model.shape;
+      }
+
+      if (attributed)
+      {
+        if (!writeModel(*attributedMesh, model.format, model.filename)) { continue; }
+      }
+      else
+      {
+        if (mesh->vertices.size() > maxVertices) { continue; }
+
+        const bool written = visitMeshPrecision(model.precision, [&](auto precisionMesh) {
+          using Mesh = decltype(precisionMesh);
+          if constexpr (std::is_same_v<Mesh, TriangleMesh>)
+          {
+            return writeModel(*mesh, model.format, model.filename);
+          }
+          else { return writeModel(convertMesh<Mesh>(*mesh), model.format, model.filename); }
+        });
+        if (!written) { continue; }
+      }
+    }
+
+    models.push_back(std::move(model));
+  }
+
+  return models;
+}
+
+bool generateModel(const GeneratedModel &model)
+{
+  if (std::filesystem::exists(model.filename)) { return true; }
+
+  std::error_code ec;
+  std::filesystem::create_directories(model.filename.parent_path(), ec);
+  if (ec) { return false; }
+
+  if (model.attributed) { return writeModel(model.attributedMesh(), model.format, model.filename); }
+
+  if (model.precision == MeshPrecision::Int64 && MeshStream::supports(model.shape))
+  {
+    return writeModel(model.stream(), model.format, model.filename);
+  }
+
+  return visitMeshPrecision(model.precision, [&](auto precisionMesh) {
+    using Mesh = decltype(precisionMesh);
+    if constexpr (std::is_same_v<Mesh, Int64TriangleMesh>)
+    {
+      return writeModel(
+          createMesh<Mesh>(model.shape, model.numTriangles, model.seed), model.format, model.filename);
+    }
+    else
+    {
+      const TriangleMesh mesh = model.mesh();
+      if (mesh.vertices.size() > maxMeshVertices(model.precision)) { return false; }
+      return writeModel(convertMesh<Mesh>(mesh), model.format, model.filename);
+    }
+  });
+}
+
+std::vector<GeneratedPolygonModel> polygonCorpusModels(
+    const std::filesystem::path &directory,
+    std::int32_t numFaces,
+    std::uint32_t seed,
+    const std::vector<PolygonMix> &mixes)
+{
+  std::vector<GeneratedPolygonModel> models;
+
+  for (PolygonMix mix : mixes)
+  {
+    const std::string mixName = polygonMixToString(mix);
+    const std::string basename = modelBasename(mixName, numFaces, seed);
+    for (Format format : {Format::Ascii, Format::BinaryLittleEndian, Format::BinaryBigEndian})
+    {
+      models.push_back(GeneratedPolygonModel{
+          mixName + ' ' + triangleCountToString(numFaces) + " faces (" + modelFormatName(format) + ')',
+          directory / (basename + '_' + formatToFilenameSuffix(format) + ".ply"),
+          mix,
+          format,
+          numFaces,
+          seed});
+    }
+  }
+
+  return models;
+}
+
+std::vector<GeneratedPolygonModel> generatePolygonCorpus(
+    const std::filesystem::path &directory,
+    std::int32_t numFaces,
+    std::uint32_t seed,
+    const std::vector<PolygonMix> &mixes)
+{
+  std::vector<GeneratedPolygonModel> models;
+
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec) { return models; }
+
+  std::optional<PolygonMesh> mesh;
+  std::optional<PolygonMix> meshMix;
+  for (GeneratedPolygonModel &model : polygonCorpusModels(directory, numFaces, seed, mixes))
+  {
+    if (!std::filesystem::exists(model.filename))
+    {
+      if (meshMix != model.mix)
+      {
+        mesh = model.mesh();
+        meshMix = model.mix;
+      }
+      if (!writeModel(*mesh, model.format, model.filename)) { continue; }
+    }
+
+    models.push_back(std::move(model));
+  }
+
+  return models;
+}
+
+bool evictFromPageCache(const std::filesystem::path &filename)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) { return false; }
+
+  // Dirty pages are not evicted by POSIX_FADV_DONTNEED, which is the case for
+  // models that were generated right before running the benchmarks.
+  const bool success = fdatasync(fd) == 0 && posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+  close(fd);
+  return success;
+}
+
+std::optional<PlyHeader> readPlyHeader(const std::filesystem::path &filename)
+{
+  std::ifstream ifs{filename, std::ios::binary};
+
+  std::string line;
+  if (!std::getline(ifs, line) || line.rfind("ply", 0) != 0) { return std::nullopt; }
+
+  std::optional<Format> format;
+  PlyHeader header{};
+  while (std::getline(ifs, line))
+  {
+    if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+
+    std::istringstream iss{line};
+    std::string keyword;
+    iss >> keyword;
+    if (keyword == "format")
+    {
+      std::string name;
+      iss >> name;
+      if (name == "ascii") { format = Format::Ascii; }
+      else if (name == "binary_little_endian") { format = Format::BinaryLittleEndian; }
+      else if (name == "binary_big_endian") { format = Format::BinaryBigEndian; }
+    }
+    else if (keyword == "element")
+    {
+      std::string name;
+      std::int64_t count = 0;
+      iss >> name >> count;
+      if (name == "vertex") { header.numVertices = count; }
+      else if (name == "face") { header.numFaces = count; }
+      header.elements.push_back(PlyElement{name, count, {}});
+    }
+    else if (keyword == "property")
+    {
+      if (header.elements.empty()) { return std::nullopt; }
+
+      PlyProperty property;
+      iss >> property.type;
+      if (property.type == "list")
+      {
+        std::string sizeType;
+        iss >> sizeType >> property.type;
+        property.sizeType = normalizePlyType(sizeType);
+      }
+      iss >> property.name;
+      property.type = normalizePlyType(property.type);
+      header.elements.back().properties.push_back(std::move(property));
+    }
+    else if (keyword == "end_header")
+    {
+      if (!format) { return std::nullopt; }
+
+      header.format = *format;
+      header.size = ifs.tellg();
+      return header;
+    }
+  }
+
+  return std::nullopt;
+}
+
+const PlyProperty *PlyElement::property(const std::string &name) const
+{
+  auto it = std::find_if(properties.begin(), properties.end(), [&](const PlyProperty &property) {
+    return property.name == name;
+  });
+  return it != properties.end() ? &*it : nullptr;
+}
+
+const PlyElement *PlyHeader::element(const std::string &name) const
+{
+  auto it = std::find_if(
+      elements.begin(), elements.end(), [&](const PlyElement &element) { return element.name == name; });
+  return it != elements.end() ? &*it : nullptr;
+}
+
+bool hasTriangleMeshLayout(const PlyHeader &header)
+{
+  const PlyElement *vertex = header.element("vertex");
+  const PlyElement *face = header.element("face");
+  if (!vertex || !face) { return false; }
+
+  for (const char *name : {"x", "y", "z"})
+  {
+    const PlyProperty *property = vertex->property(name);
+    if (!property || property->sizeType) { return false; }
+  }
+
+  const PlyProperty *indices = face->property("vertex_indices");
+  return indices && indices->sizeType;
+}
+
+std::vector<ModelFile> findModels(const std::filesystem::path &path)
+{
+  std::vector<ModelFile> models;
+
+  auto addModel = [&](const std::filesystem::path &filename, std::string name) {
+    std::optional<PlyHeader> header = readPlyHeader(filename);
+    if (name.empty())
+    {
+      name = filename.stem().string();
+      if (header) { name += " (" + modelFormatName(header->format) + ')'; }
+    }
+    models.push_back(ModelFile{std::move(name), filename, std::move(header)});
+  };
+
+  std::error_code ec;
+  if (std::filesystem::is_directory(path, ec))
+  {
+    std::vector<std::filesystem::path> filenames;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(path, ec))
+    {
+      std::string extension = entry.path().extension().string();
+      std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) {
+        return std::tolower(c);
+      });
+      if (entry.is_regular_file(ec) && extension == ".ply") { filenames.push_back(entry.path()); }
+    }
+
+    std::sort(filenames.begin(), filenames.end());
+    for (const std::filesystem::path &filename : filenames) { addModel(filename, {}); }
+    return models;
+  }
+
+  std::ifstream manifest{path};
+  std::string line;
+  while (std::getline(manifest, line))
+  {
+    if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+    if (line.empty() || line[0] == '#') { continue; }
+
+    const std::size_t tab = line.find('\t');
+    const std::filesystem::path filename{line.substr(0, tab)};
+    addModel(
+        filename.is_relative() ? path.parent_path() / filename : filename,
+        tab != std::string::npos ? line.substr(tab + 1) : std::string{});
+  }
+
+  return models;
+}
+
+double pageCacheResidency(const std::filesystem::path &filename)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) { return -1; }
+
+  const off_t size = lseek(fd, 0, SEEK_END);
+  if (size <= 0)
+  {
+    close(fd);
+    return size == 0 ? 0 : -1;
+  }
+
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) { return -1; }
+
+  const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+  const std::size_t numPages = (size + pageSize - 1) / pageSize;
+  std::vector<unsigned char> residency(numPages);
+
+  double result = -1;
+  if (mincore(addr, size, residency.data()) == 0)
+  {
+    auto isResident = [](unsigned char c) { return c & 1; };
+    result = double(std::count_if(residency.begin(), residency.end(), isResident)) / numPages;
+  }
+
+  munmap(addr, size);
+  return result;
+}
+
+void flushCpuCaches(std::size_t size)
+{
+  // Writing a single byte per cache line suffices to replace every line, and
+  // makes sure that dirty lines are written back before the caller continues.
+  constexpr std::size_t cacheLineSize = 64;
 
-  for (std::int32_t i = 0; i < numTriangles; ++i) { triangles.push_back(Triangle{i, i + 1, i + 2}); }
+  thread_local std::vector<char> buffer;
+  if (buffer.size() < size) { buffer.resize(size); }
 
-  return TriangleMesh{std::move(triangles), std::move(vertices)};
+  volatile char *data = buffer.data();
+  for (std::size_t i = 0; i < size; i += cacheLineSize) { data[i] = data[i] + 1; }
 }
 
-std::filesystem::path uniquePath()
+std::filesystem::path uniquePath(const std::filesystem::path &directory)
 {
-  auto path = std::filesystem::temp_directory_path();
+  const std::filesystem::path path = directory.empty() ? std::filesystem::temp_directory_path() : directory;
   std::string suffix = "x";
   while (std::filesystem::exists(path / suffix)) { suffix += char(rand() % 26 + 65); }
   return path / suffix;
@@ -5,11 +5,383 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <optional>
+#include <random>
 #include <string>
+#include <vector>
 
-TriangleMesh createMesh(std::int32_t numTriangles);
+enum class Format { Ascii, BinaryLittleEndian, BinaryBigEndian };
 
-std::filesystem::path uniquePath();
+inline std::string formatToString(Format format)
+{
+  switch (format)
+  {
+    case Format::Ascii:
+      return "ASCII";
+    case Format::BinaryBigEndian:
+      return "Binary big endian";
+    case Format::BinaryLittleEndian:
+      return "Binary little endian";
+  }
+
+  return {};
+}
+
+// Shapes of the synthetic meshes that can be generated by `createMesh()`. A
+// strip is the degenerate triangle strip used by the write benchmarks; the other
+// shapes are meant to resemble real world models.
+enum class MeshShape { Strip, Sphere, NoisyGrid, ScannedSurface };
+
+// Mesh shapes that are part of the synthetic corpus.
+inline const std::vector<MeshShape> corpusMeshShapes{
+    MeshShape::Sphere, MeshShape::NoisyGrid, MeshShape::ScannedSurface};
+
+std::string meshShapeToString(MeshShape shape);
+
+TriangleMesh createMesh(std::int64_t numTriangles);
+
+// Generates a mesh with exactly the given number of triangles, using the index
+// type of the given mesh type. Generation is deterministic for a given shape,
+// size and seed. Vertex coordinates are rounded to six significant digits, so
+// that an ASCII PLY file round trips exactly, regardless of the float parser
+// used by a PLY library. Supports `TriangleMesh` and `Int64TriangleMesh`.
+template<typename Mesh = TriangleMesh>
+Mesh createMesh(MeshShape shape, std::int64_t numTriangles, std::uint32_t seed = 0);
+
+// Generates the mesh `createMesh()` generates one vertex and one triangle at a
+// time, using 64-bit indices, so that meshes with billions of vertices can be
+// written and checked without holding them in memory. The scanned surface shape
+// is not supported, since it shuffles all of its vertices and triangles.
+class MeshStream
+{
+public:
+  MeshStream(MeshShape shape, std::int64_t numTriangles, std::uint32_t seed = 0);
+
+  // Returns whether meshes of the given shape can be streamed.
+  static bool supports(MeshShape shape) { return shape != MeshShape::ScannedSurface; }
+
+  std::int64_t numVertices() const { return numVertices_; }
+  std::int64_t numTriangles() const { return numTriangles_; }
+
+  // Returns the next vertex, starting at the first vertex. Vertices are
+  // generated in order, since the noise of a noisy grid is drawn from a single
+  // random number generator.
+  Vertex nextVertex();
+
+  // Returns the triangle with the given index.
+  BasicTriangle<std::int64_t> triangle(std::int64_t index) const;
+
+private:
+  MeshShape shape_;
+  std::int64_t numTriangles_{0};
+  std::int64_t numVertices_{0};
+  // Number of quads of a grid, or number of slices and stacks of a sphere.
+  std::int64_t columns_{0};
+  std::int64_t rows_{0};
+  std::int64_t vertex_{0};
+  std::mt19937 rng_;
+  std::normal_distribution<float> noise_;
+};
+
+// Returns whether the given mesh equals the mesh generated by the given stream,
+// after converting its coordinates to `float`; see `MeshStream`. This checks
+// the mesh parsed from a huge model without generating a second mesh in memory.
+template<typename Coordinate, typename Index>
+bool matchesGeneratedMesh(const BasicTriangleMesh<Coordinate, Index> &mesh, MeshStream stream);
+
+// Generates a mesh like `createMesh()` does, with a normal, a color and texture
+// coordinates for every vertex. Normals are the normalized sum of the face
+// normals around a vertex, weighted by area, colors encode the normal, and
+// texture coordinates are the normalized x and y coordinates of a vertex. Like
+// vertex coordinates, normals and texture coordinates are rounded to six
+// significant digits.
+AttributedTriangleMesh createAttributedMesh(
+    MeshShape shape,
+    std::int64_t numTriangles,
+    std::uint32_t seed = 0);
+
+// Coordinate and index types of the triangle mesh types; `float` coordinates and
+// `int` indices for `TriangleMesh`, and a single other type for the others.
+enum class MeshPrecision { Float, Double, UInt32, UInt16, Int64 };
+
+inline const std::vector<MeshPrecision> meshPrecisions{
+    MeshPrecision::Float, MeshPrecision::Double, MeshPrecision::UInt32, MeshPrecision::UInt16,
+    MeshPrecision::Int64};
+
+// Returns the types that differ from those of `TriangleMesh` for the given
+// precision, like `double coordinates` or `ushort indices`, or an empty string.
+std::string meshPrecisionToString(MeshPrecision precision);
+
+// Returns the number of vertices a triangle mesh of the given precision is able
+// to address.
+std::size_t maxMeshVertices(MeshPrecision precision);
+
+// Returns whether parsing a model storing the types of one precision into a
+// mesh of another narrows its coordinates, like `double` to `float`, or its
+// indices, like `int` to `ushort` or `uint`.
+bool isNarrowingConversion(MeshPrecision stored, MeshPrecision precision);
+
+// Calls `fn` with an empty triangle mesh of the type of the given precision, to
+// dispatch to code that is templated on the mesh type.
+template<typename Fn>
+auto visitMeshPrecision(MeshPrecision precision, Fn fn)
+{
+  switch (precision)
+  {
+    case MeshPrecision::Double:
+      return fn(DoubleTriangleMesh{});
+    case MeshPrecision::UInt32:
+      return fn(UInt32TriangleMesh{});
+    case MeshPrecision::UInt16:
+      return fn(UInt16TriangleMesh{});
+    case MeshPrecision::Int64:
+      return fn(Int64TriangleMesh{});
+    case MeshPrecision::Float:
+      break;
+  }
+
+  return fn(TriangleMesh{});
+}
+
+// Converts the coordinates and vertex indices of a triangle mesh to the types
+// of another triangle mesh type.
+template<typename Mesh, typename Coordinate, typename Index>
+Mesh convertMesh(const BasicTriangleMesh<Coordinate, Index> &mesh)
+{
+  using MeshCoordinate = typename Mesh::Coordinate;
+  using MeshIndex = typename Mesh::Index;
+
+  Mesh result;
+  result.triangles.reserve(mesh.triangles.size());
+  for (const auto &t : mesh.triangles)
+  {
+    result.triangles.push_back({MeshIndex(t.a), MeshIndex(t.b), MeshIndex(t.c)});
+  }
+  result.vertices.reserve(mesh.vertices.size());
+  for (const auto &v : mesh.vertices)
+  {
+    result.vertices.push_back({MeshCoordinate(v.x), MeshCoordinate(v.y), MeshCoordinate(v.z)});
+  }
+  return result;
+}
+
+// Converts a triangle mesh to a mesh that stores its vertices as a structure of
+// arrays, and back.
+SoaTriangleMesh toStructureOfArrays(const TriangleMesh &mesh);
+TriangleMesh toArrayOfStructures(const SoaTriangleMesh &mesh);
+
+// Mixes of faces of the synthetic polygon meshes generated by
+// `createPolygonMesh()`. A quad dominant mesh is a grid of quads, with about one
+// in ten cells split into two triangles. A mixed mesh contains triangles, quads,
+// pentagons and hexagons, like the output of a CAD application.
+enum class PolygonMix { QuadDominant, Mixed };
+
+inline const std::vector<PolygonMix> polygonMixes{PolygonMix::QuadDominant, PolygonMix::Mixed};
+
+std::string polygonMixToString(PolygonMix mix);
+
+// Generates a height field over a regular grid like the noisy grid shape of
+// `createMesh()`, with exactly the given number of faces of the given mix. All
+// faces are convex, and listed counterclockwise. Generation is deterministic
+// for a given mix, size and seed.
+PolygonMesh createPolygonMesh(PolygonMix mix, std::int32_t numFaces, std::uint32_t seed = 0);
+
+// Largest number of faces `createPolygonMesh()` generates a mesh for; faces
+// have up to six vertices, and their offsets are stored as `std::int32_t`.
+constexpr std::int64_t maxPolygonFaces = std::numeric_limits<std::int32_t>::max() / 6;
+
+// Returns the number of triangles `triangulate()` produces for the given mesh.
+std::size_t countTriangles(const PolygonMesh &mesh);
+
+// Triangulates every face of the given mesh as a fan around its first vertex,
+// which is exact for convex faces. Faces with less than three vertices are
+// dropped.
+TriangleMesh triangulate(PolygonMesh mesh);
+
+// Writes the given mesh to a PLY file in the given format, without depending on
+// any of the benchmarked PLY libraries. Returns false in case the file could not
+// be written. The coordinates and vertex indices of a triangle mesh are written
+// using the PLY types of its coordinate and index types, like `double` and
+// `ushort`. Since PLY has no 64-bit integer type, 64-bit indices are written as
+// `uint`, which fails for meshes with more than 2^32 vertices. The vertex
+// properties of an attributed mesh are written in the order `x`, `y`, `z`, `nx`,
+// `ny`, `nz`, `red`, `green`, `blue`, `alpha`, `u`, and `v`, as `uchar` for the
+// color components, and as `float` otherwise.
+template<typename Coordinate, typename Index>
+bool writeMesh(
+    const BasicTriangleMesh<Coordinate, Index> &mesh,
+    Format format,
+    const std::filesystem::path &filename);
+bool writeMesh(const AttributedTriangleMesh &mesh, Format format, const std::filesystem::path &filename);
+bool writeMesh(const PolygonMesh &mesh, Format format, const std::filesystem::path &filename);
+
+// Writes the mesh generated by the given stream like `writeMesh()` writes the
+// `Int64TriangleMesh` of the same shape, without generating it in memory.
+bool writeMesh(const MeshStream &stream, Format format, const std::filesystem::path &filename);
+
+// Describes a model from the synthetic corpus; the mesh stored in the model
+// file can be regenerated in memory using `mesh()`, or using `attributedMesh()`
+// in case the model stores vertex attributes, or streamed using `stream()` for
+// the shapes `MeshStream` supports. Models of triangle meshes store
+// the coordinate and index types of the given precision, where `mesh()` returns
+// the values converted to `float` and `int`.
+struct GeneratedModel
+{
+  std::string name;
+  std::filesystem::path filename;
+  MeshShape shape;
+  Format format;
+  std::int64_t numTriangles;
+  std::uint32_t seed;
+  bool attributed{false};
+  MeshPrecision precision{MeshPrecision::Float};
+
+  TriangleMesh mesh() const { return createMesh(shape, numTriangles, seed); }
+  AttributedTriangleMesh attributedMesh() const { return createAttributedMesh(shape, numTriangles, seed); }
+  MeshStream stream() const { return MeshStream{shape, numTriangles, seed}; }
+};
+
+// Describes the models of the synthetic corpus for the given shapes and number
+// of triangles, stored in the given directory, without generating them. The
+// models of attributed meshes are named like `Sphere with attributes 10K (ASCII)`,
+// and models that store other types than `float` and `int` are named like
+// `Sphere with double coordinates 10K (ASCII)`.
+std::vector<GeneratedModel> corpusModels(
+    const std::filesystem::path &directory,
+    std::int64_t numTriangles,
+    std::uint32_t seed = 0,
+    const std::vector<MeshShape> &shapes = corpusMeshShapes,
+    bool attributed = false,
+    MeshPrecision precision = MeshPrecision::Float);
+
+// Generates a PLY file for the given mesh shapes in all formats with the given
+// number of triangles in the given directory, storing vertex attributes in case
+// `attributed` is set, or storing the types of the given precision otherwise.
+// Models that were generated before are reused, and models with more vertices
+// than their index type is able to address are skipped. Models with 64-bit
+// indices are generated using `generateModel()`. Returns the models that are
+// available.
+std::vector<GeneratedModel> generateCorpus(
+    const std::filesystem::path &directory,
+    std::int64_t numTriangles,
+    std::uint32_t seed = 0,
+    const std::vector<MeshShape> &shapes = corpusMeshShapes,
+    bool attributed = false,
+    MeshPrecision precision = MeshPrecision::Float);
+
+// Generates the file of a single model described by `corpusModels()`, unless it
+// was generated before, and returns whether it is available. Models with 64-bit
+// indices are streamed to file for the shapes `MeshStream` supports, so that
+// huge models never reside in memory.
+bool generateModel(const GeneratedModel &model);
+
+// Describes a polygon model from the synthetic corpus, see `GeneratedModel`.
+struct GeneratedPolygonModel
+{
+  std::string name;
+  std::filesystem::path filename;
+  PolygonMix mix;
+  Format format;
+  std::int32_t numFaces;
+  std::uint32_t seed;
+
+  PolygonMesh mesh() const { return createPolygonMesh(mix, numFaces, seed); }
+};
+
+// Describes and generates the polygon models of the synthetic corpus, like
+// `corpusModels()` and `generateCorpus()` do for triangle meshes. Models are
+// named like `Mixed polygons 10K faces (ASCII)`.
+std::vector<GeneratedPolygonModel> polygonCorpusModels(
+    const std::filesystem::path &directory,
+    std::int32_t numFaces,
+    std::uint32_t seed = 0,
+    const std::vector<PolygonMix> &mixes = polygonMixes);
+std::vector<GeneratedPolygonModel> generatePolygonCorpus(
+    const std::filesystem::path &directory,
+    std::int32_t numFaces,
+    std::uint32_t seed = 0,
+    const std::vector<PolygonMix> &mixes = polygonMixes);
+
+// Property of an element in a PLY header. Types are normalized to the names
+// `char`, `uchar`, `short`, `ushort`, `int`, `uint`, `float` and `double`, so
+// `float32` is reported as `float`, for example. List properties also have the
+// type of the size of the list.
+struct PlyProperty
+{
+  std::string name;
+  std::string type;
+  std::optional<std::string> sizeType;
+};
+
+struct PlyElement
+{
+  std::string name;
+  std::int64_t count{0};
+  std::vector<PlyProperty> properties;
+
+  // Returns the property with the given name, or a null pointer.
+  const PlyProperty *property(const std::string &name) const;
+};
+
+// Summary of a PLY header; the number of vertices and faces is zero in case the
+// header does not define a vertex or face element.
+struct PlyHeader
+{
+  Format format;
+  std::int64_t numVertices{0};
+  std::int64_t numFaces{0};
+  std::size_t size{0};
+  std::vector<PlyElement> elements;
+
+  // Returns the element with the given name, or a null pointer.
+  const PlyElement *element(const std::string &name) const;
+};
+
+// Reads the header of the given PLY file. Returns an empty optional in case the
+// file could not be read, or is not a PLY file.
+std::optional<PlyHeader> readPlyHeader(const std::filesystem::path &filename);
+
+// Returns whether the given header describes a triangle mesh the way all parse
+// adaptors read it: a `vertex` element with `x`, `y` and `z` properties, and a
+// `face` element with a `vertex_indices` list property.
+bool hasTriangleMeshLayout(const PlyHeader &header);
+
+// Describes a model that was found by `findModels()`; the header is empty in
+// case the model could not be read, or is not a PLY file.
+struct ModelFile
+{
+  std::string name;
+  std::filesystem::path filename;
+  std::optional<PlyHeader> header;
+};
+
+// Finds the models to benchmark, given either a directory, which is searched
+// recursively for files with a `.ply` extension, or a manifest file, which lists
+// one model per line as a filename, optionally followed by a tab and the name of
+// the model. Relative filenames in a manifest are relative to the directory of
+// the manifest; empty lines and lines starting with `#` are ignored. Unless a
+// name is given, a model is named after its filename and format, like
+// `bunny (ASCII)`. Models in a directory are sorted by filename.
+std::vector<ModelFile> findModels(const std::filesystem::path &path);
+
+// Evicts the pages of the given file from the page cache, writing back dirty
+// pages first. Returns false in case the pages could not be evicted.
+bool evictFromPageCache(const std::filesystem::path &filename);
+
+// Returns the fraction of the pages of the given file that currently reside in
+// the page cache, or a negative value in case this could not be determined.
+double pageCacheResidency(const std::filesystem::path &filename);
+
+// Evicts all data from the CPU caches by writing to every cache line of a buffer
+// of the given size, which should be larger than the last level cache. The
+// buffer is allocated on first use, and reused by subsequent calls from the same
+// thread.
+void flushCpuCaches(std::size_t size);
+
+// Returns a path to a file that does not exist yet in the given directory, or
+// in the directory for temporary files in case no directory is given.
+std::filesystem::path uniquePath(const std::filesystem::path &directory = {});
 
 class TemporaryFile
 {
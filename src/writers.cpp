@@ -7,6 +7,7 @@
 #include <miniply/miniply.h>
 #include <plywoot/plywoot.hpp>
 #include <rply/rply.h>
+#include <rply/rplyfile.h>
 #include <tinyply/source/tinyply.h>
 #include <vcglib/wrap/nanoply/include/nanoply.hpp>
 #include <vcglib/wrap/ply/plylib.h>
@@ -15,7 +16,21 @@
 #include <fstream>
 #include <string>
 
-TemporaryFile writeHapply(const TriangleMesh &mesh, Format format)
+namespace {
+void addHapplyTriangles(happly::PLYData &plyOut, const Triangles &triangles)
+{
+  std::vector<std::vector<int>> indices;
+  indices.reserve(triangles.size());
+  for (const Triangle &t : triangles)
+  {
+    std::vector<int> triangle = {t.a, t.b, t.c};
+    indices.push_back(std::move(triangle));
+  }
+
+  plyOut.getElement("face").addListProperty<int>("vertex_indices", indices);
+}
+
+void writeHapply(const TriangleMesh &mesh, Format format, std::ostream &os)
 {
   happly::PLYData plyOut;
 
@@ -40,22 +55,12 @@ TemporaryFile writeHapply(const TriangleMesh &mesh, Format format)
   plyOut.getElement("vertex").addProperty<float>("y", y);
   plyOut.getElement("vertex").addProperty<float>("z", z);
 
-  std::vector<std::vector<int>> indices;
-  indices.reserve(mesh.triangles.size());
-  for (const Triangle &t : mesh.triangles)
-  {
-    std::vector<int> triangle = {t.a, t.b, t.c};
-    indices.push_back(std::move(triangle));
-  }
+  addHapplyTriangles(plyOut, mesh.triangles);
 
-  plyOut.getElement("face").addListProperty<int>("vertex_indices", indices);
-
-  TemporaryFile tf;
-  plyOut.write(tf.stream(), format == Format::Ascii ? happly::DataFormat::ASCII : happly::DataFormat::Binary);
-  return tf;
+  plyOut.write(os, format == Format::Ascii ? happly::DataFormat::ASCII : happly::DataFormat::Binary);
 }
 
-TemporaryFile writeMshPly(const TriangleMesh &mesh, Format format)
+bool writeMshPly(const TriangleMesh &mesh, Format format, const std::filesystem::path &filename)
 {
   const char *vertexProperties[] = {"x", "y", "z"};
   const char *triangleProperties[] = {"vertex_indices"};
@@ -86,9 +91,8 @@ TemporaryFile writeMshPly(const TriangleMesh &mesh, Format format)
   faceDescriptor.data_count = &numTriangles;
   faceDescriptor.list_size_hint = 3;
 
-  TemporaryFile tf;
-
-  msh_ply_t *pf = msh_ply_open(tf.filename().c_str(), format == Format::Ascii ? "w" : "wb");
+  msh_ply_t *pf = msh_ply_open(filename.c_str(), format == Format::Ascii ? "w" : "wb");
+  const bool success = pf != nullptr;
   if (pf)
   {
     msh_ply_add_descriptor(pf, &vertexDescriptor);
@@ -97,10 +101,10 @@ TemporaryFile writeMshPly(const TriangleMesh &mesh, Format format)
   }
   msh_ply_close(pf);
 
-  return tf;
+  return success;
 }
 
-TemporaryFile writeNanoPly(const TriangleMesh &mesh, Format format)
+bool writeNanoPly(const TriangleMesh &mesh, Format format, const std::filesystem::path &filename)
 {
   std::vector<nanoply::PlyProperty> vertexProperty;
   vertexProperty.push_back(nanoply::PlyProperty(nanoply::NNP_FLOAT32, nanoply::NNP_PXYZ));
@@ -129,22 +133,20 @@ TemporaryFile writeNanoPly(const TriangleMesh &mesh, Format format)
 
   std::vector<nanoply::ElementDescriptor *> meshDescriptors = {&vertex, &face};
 
-  TemporaryFile tf;
-
   nanoply::Info info;
-  info.filename = tf.filename();
+  info.filename = filename;
   info.binary = format != Format::Ascii;
   info.AddPlyElement(vertexElement);
   info.AddPlyElement(faceElement);
-  nanoply::SaveModel(info.filename, meshDescriptors, info);
+  const bool success = nanoply::SaveModel(info.filename, meshDescriptors, info);
 
   for (std::size_t i = 0; i < vertex.dataDescriptor.size(); i++) { delete vertex.dataDescriptor[i]; }
   for (std::size_t i = 0; i < face.dataDescriptor.size(); i++) { delete face.dataDescriptor[i]; }
 
-  return tf;
+  return success;
 }
 
-TemporaryFile writePlywoot(const TriangleMesh &mesh, Format format)
+void writePlywoot(const TriangleMesh &mesh, Format format, std::ostream &os)
 {
   plywoot::OStream plyos{
       format == Format::Ascii ? plywoot::PlyFormat::Ascii : plywoot::PlyFormat::BinaryLittleEndian};
@@ -165,18 +167,11 @@ TemporaryFile writePlywoot(const TriangleMesh &mesh, Format format)
   plyos.add(vertexElement, VertexLayout{mesh.vertices});
   plyos.add(faceElement, TriangleLayout{mesh.triangles});
 
-  TemporaryFile tf;
-  plyos.write(tf.stream());
-  return tf;
+  plyos.write(os);
 }
 
-TemporaryFile writeRPly(const TriangleMesh &mesh, Format format)
+bool writeRPly(const TriangleMesh &mesh, p_ply ply)
 {
-  TemporaryFile tf;
-
-  const e_ply_storage_mode mode = format == Format::Ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN;
-  p_ply ply = ply_create(tf.filename().c_str(), mode, NULL, 0, NULL);
-
   if (ply)
   {
     ply_add_element(ply, "vertex", mesh.vertices.size());
@@ -204,16 +199,14 @@ TemporaryFile writeRPly(const TriangleMesh &mesh, Format format)
       ply_write(ply, t.c);
     }
 
-    ply_close(ply);
+    return ply_close(ply);
   }
 
-  return tf;
+  return false;
 }
 
-TemporaryFile writeTinyply(const TriangleMesh &mesh, Format format)
+void writeTinyply(const TriangleMesh &mesh, Format format, std::ostream &os)
 {
-  TemporaryFile tf;
-
   tinyply::PlyFile outFile;
   outFile.add_properties_to_element(
       "vertex", {"x", "y", "z"}, tinyply::Type::FLOAT32, mesh.vertices.size(),
@@ -221,7 +214,544 @@ TemporaryFile writeTinyply(const TriangleMesh &mesh, Format format)
   outFile.add_properties_to_element(
       "face", {"vertex_indices"}, tinyply::Type::UINT32, mesh.triangles.size(),
       reinterpret_cast<uint8_t *>(const_cast<Triangle *>(mesh.triangles.data())), tinyply::Type::UINT8, 3);
-  outFile.write(tf.stream(), format != Format::Ascii);
+  outFile.write(os, format != Format::Ascii);
+}
+
+void writeSoaHapply(const SoaTriangleMesh &mesh, Format format, std::ostream &os)
+{
+  happly::PLYData plyOut;
+
+  plyOut.addElement("vertex", mesh.vertices.size());
+  plyOut.addElement("face", mesh.triangles.size());
+
+  plyOut.getElement("vertex").addProperty<float>("x", mesh.vertices.x);
+  plyOut.getElement("vertex").addProperty<float>("y", mesh.vertices.y);
+  plyOut.getElement("vertex").addProperty<float>("z", mesh.vertices.z);
+
+  addHapplyTriangles(plyOut, mesh.triangles);
+
+  plyOut.write(os, format == Format::Ascii ? happly::DataFormat::ASCII : happly::DataFormat::Binary);
+}
+
+bool writeSoaMshPly(const SoaTriangleMesh &mesh, Format format, const std::filesystem::path &filename)
+{
+  const char *xProperties[] = {"x"};
+  const char *yProperties[] = {"y"};
+  const char *zProperties[] = {"z"};
+  const char *triangleProperties[] = {"vertex_indices"};
+
+  float *x = const_cast<float *>(mesh.vertices.x.data());
+  float *y = const_cast<float *>(mesh.vertices.y.data());
+  float *z = const_cast<float *>(mesh.vertices.z.data());
+  Triangle *triangles = const_cast<Triangle *>(mesh.triangles.data());
+  std::int32_t numTriangles = mesh.triangles.size();
+  std::int32_t numVertices = mesh.vertices.size();
+
+  auto vertexDescriptor = [&](const char **properties, float **data) {
+    msh_ply_desc_t descriptor;
+    descriptor.element_name = const_cast<char *>("vertex");
+    descriptor.property_names = properties;
+    descriptor.num_properties = 1;
+    descriptor.data_type = MSH_PLY_FLOAT;
+    descriptor.list_type = MSH_PLY_INVALID;
+    descriptor.data = data;
+    descriptor.list_data = nullptr;
+    descriptor.data_count = &numVertices;
+    return descriptor;
+  };
+  msh_ply_desc_t xDescriptor = vertexDescriptor(xProperties, &x);
+  msh_ply_desc_t yDescriptor = vertexDescriptor(yProperties, &y);
+  msh_ply_desc_t zDescriptor = vertexDescriptor(zProperties, &z);
+
+  msh_ply_desc_t faceDescriptor;
+  faceDescriptor.element_name = const_cast<char *>("face");
+  faceDescriptor.property_names = triangleProperties;
+  faceDescriptor.num_properties = 1;
+  faceDescriptor.data_type = MSH_PLY_INT32;
+  faceDescriptor.list_type = MSH_PLY_UINT8;
+  faceDescriptor.data = &triangles;
+  faceDescriptor.list_data = nullptr;
+  faceDescriptor.data_count = &numTriangles;
+  faceDescriptor.list_size_hint = 3;
+
+  msh_ply_t *pf = msh_ply_open(filename.c_str(), format == Format::Ascii ? "w" : "wb");
+  const bool success = pf != nullptr;
+  if (pf)
+  {
+    msh_ply_add_descriptor(pf, &xDescriptor);
+    msh_ply_add_descriptor(pf, &yDescriptor);
+    msh_ply_add_descriptor(pf, &zDescriptor);
+    msh_ply_add_descriptor(pf, &faceDescriptor);
+    msh_ply_write(pf);
+  }
+  msh_ply_close(pf);
+
+  return success;
+}
+
+bool writeSoaRPly(const SoaTriangleMesh &mesh, p_ply ply)
+{
+  if (ply)
+  {
+    ply_add_element(ply, "vertex", mesh.vertices.size());
+    ply_add_scalar_property(ply, "x", PLY_FLOAT);
+    ply_add_scalar_property(ply, "y", PLY_FLOAT);
+    ply_add_scalar_property(ply, "z", PLY_FLOAT);
 
+    ply_add_element(ply, "face", mesh.triangles.size());
+    ply_add_list_property(ply, "vertex_indices", PLY_UINT8, PLY_INT);
+
+    ply_write_header(ply);
+
+    const SoaVertices &vertices = mesh.vertices;
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+      ply_write(ply, vertices.x[i]);
+      ply_write(ply, vertices.y[i]);
+      ply_write(ply, vertices.z[i]);
+    }
+
+    for (const Triangle &t : mesh.triangles)
+    {
+      ply_write(ply, 3);
+      ply_write(ply, t.a);
+      ply_write(ply, t.b);
+      ply_write(ply, t.c);
+    }
+
+    return ply_close(ply);
+  }
+
+  return false;
+}
+
+void writeSoaTinyply(const SoaTriangleMesh &mesh, Format format, std::ostream &os)
+{
+  tinyply::PlyFile outFile;
+  for (const auto &[name, coordinates] :
+       {std::make_pair("x", &mesh.vertices.x), std::make_pair("y", &mesh.vertices.y),
+        std::make_pair("z", &mesh.vertices.z)})
+  {
+    outFile.add_properties_to_element(
+        "vertex", {name}, tinyply::Type::FLOAT32, coordinates->size(),
+        reinterpret_cast<uint8_t *>(const_cast<float *>(coordinates->data())), tinyply::Type::INVALID, 0);
+  }
+  outFile.add_properties_to_element(
+      "face", {"vertex_indices"}, tinyply::Type::UINT32, mesh.triangles.size(),
+      reinterpret_cast<uint8_t *>(const_cast<Triangle *>(mesh.triangles.data())), tinyply::Type::UINT8, 3);
+  outFile.write(os, format != Format::Ascii);
+}
+
+// Returns the values of the given member of all vertices.
+template<typename T>
+std::vector<T> vertexMemberValues(const AttributedVertices &vertices, T AttributedVertex::*member)
+{
+  std::vector<T> values;
+  values.reserve(vertices.size());
+  for (const AttributedVertex &v : vertices) { values.push_back(v.*member); }
+  return values;
+}
+
+// Splits attributed vertices into arrays of the float properties, the colors,
+// and the texture coordinates, for the libraries that require the properties
+// written together to be of the same type.
+struct SplitAttributedVertices
+{
+  std::vector<float> floats;
+  std::vector<std::uint8_t> colors;
+  std::vector<float> textureCoordinates;
+
+  explicit SplitAttributedVertices(const AttributedVertices &vertices)
+  {
+    floats.reserve(6 * vertices.size());
+    colors.reserve(4 * vertices.size());
+    textureCoordinates.reserve(2 * vertices.size());
+    for (const AttributedVertex &v : vertices)
+    {
+      floats.insert(floats.end(), {v.x, v.y, v.z, v.nx, v.ny, v.nz});
+      colors.insert(colors.end(), {v.red, v.green, v.blue, v.alpha});
+      textureCoordinates.insert(textureCoordinates.end(), {v.u, v.v});
+    }
+  }
+};
+
+// Note that the properties are written in the same order as in generated models,
+// see `writeMesh()`.
+void writeAttributedHapply(const AttributedTriangleMesh &mesh, Format format, std::ostream &os)
+{
+  happly::PLYData plyOut;
+
+  plyOut.addElement("vertex", mesh.vertices.size());
+  plyOut.addElement("face", mesh.triangles.size());
+
+  const AttributedVertices &vertices = mesh.vertices;
+  happly::Element &vertexElement = plyOut.getElement("vertex");
+  vertexElement.addProperty<float>("x", vertexMemberValues(vertices, &AttributedVertex::x));
+  vertexElement.addProperty<float>("y", vertexMemberValues(vertices, &AttributedVertex::y));
+  vertexElement.addProperty<float>("z", vertexMemberValues(vertices, &AttributedVertex::z));
+  vertexElement.addProperty<float>("nx", vertexMemberValues(vertices, &AttributedVertex::nx));
+  vertexElement.addProperty<float>("ny", vertexMemberValues(vertices, &AttributedVertex::ny));
+  vertexElement.addProperty<float>("nz", vertexMemberValues(vertices, &AttributedVertex::nz));
+  vertexElement.addProperty<std::uint8_t>("red", vertexMemberValues(vertices, &AttributedVertex::red));
+  vertexElement.addProperty<std::uint8_t>("green", vertexMemberValues(vertices, &AttributedVertex::green));
+  vertexElement.addProperty<std::uint8_t>("blue", vertexMemberValues(vertices, &AttributedVertex::blue));
+  vertexElement.addProperty<std::uint8_t>("alpha", vertexMemberValues(vertices, &AttributedVertex::alpha));
+  vertexElement.addProperty<float>("u", vertexMemberValues(vertices, &AttributedVertex::u));
+  vertexElement.addProperty<float>("v", vertexMemberValues(vertices, &AttributedVertex::v));
+
+  addHapplyTriangles(plyOut, mesh.triangles);
+
+  plyOut.write(os, format == Format::Ascii ? happly::DataFormat::ASCII : happly::DataFormat::Binary);
+}
+
+bool writeAttributedMshPly(
+    const AttributedTriangleMesh &mesh, Format format, const std::filesystem::path &filename)
+{
+  const char *floatProperties[] = {"x", "y", "z", "nx", "ny", "nz"};
+  const char *colorProperties[] = {"red", "green", "blue", "alpha"};
+  const char *textureProperties[] = {"u", "v"};
+  const char *triangleProperties[] = {"vertex_indices"};
+
+  SplitAttributedVertices split{mesh.vertices};
+  float *floats = split.floats.data();
+  std::uint8_t *colors = split.colors.data();
+  float *textureCoordinates = split.textureCoordinates.data();
+  Triangle *triangles = const_cast<Triangle *>(mesh.triangles.data());
+  std::int32_t numTriangles = mesh.triangles.size();
+  std::int32_t numVertices = mesh.vertices.size();
+
+  auto vertexDescriptor =
+      [&](const char **properties, std::int32_t numProperties, msh_ply_type_id_t dataType, void *data) {
+        msh_ply_desc_t descriptor;
+        descriptor.element_name = const_cast<char *>("vertex");
+        descriptor.property_names = properties;
+        descriptor.num_properties = numProperties;
+        descriptor.data_type = dataType;
+        descriptor.list_type = MSH_PLY_INVALID;
+        descriptor.data = data;
+        descriptor.list_data = nullptr;
+        descriptor.data_count = &numVertices;
+        return descriptor;
+      };
+  msh_ply_desc_t floatDescriptor = vertexDescriptor(floatProperties, 6, MSH_PLY_FLOAT, &floats);
+  msh_ply_desc_t colorDescriptor = vertexDescriptor(colorProperties, 4, MSH_PLY_UINT8, &colors);
+  msh_ply_desc_t textureDescriptor =
+      vertexDescriptor(textureProperties, 2, MSH_PLY_FLOAT, &textureCoordinates);
+
+  msh_ply_desc_t faceDescriptor;
+  faceDescriptor.element_name = const_cast<char *>("face");
+  faceDescriptor.property_names = triangleProperties;
+  faceDescriptor.num_properties = 1;
+  faceDescriptor.data_type = MSH_PLY_INT32;
+  faceDescriptor.list_type = MSH_PLY_UINT8;
+  faceDescriptor.data = &triangles;
+  faceDescriptor.list_data = nullptr;
+  faceDescriptor.data_count = &numTriangles;
+  faceDescriptor.list_size_hint = 3;
+
+  msh_ply_t *pf = msh_ply_open(filename.c_str(), format == Format::Ascii ? "w" : "wb");
+  const bool success = pf != nullptr;
+  if (pf)
+  {
+    msh_ply_add_descriptor(pf, &floatDescriptor);
+    msh_ply_add_descriptor(pf, &colorDescriptor);
+    msh_ply_add_descriptor(pf, &textureDescriptor);
+    msh_ply_add_descriptor(pf, &faceDescriptor);
+    msh_ply_write(pf);
+  }
+  msh_ply_close(pf);
+
+  return success;
+}
+
+bool writeAttributedNanoPly(
+    const AttributedTriangleMesh &mesh, Format format, const std::filesystem::path &filename)
+{
+  std::vector<nanoply::PlyProperty> vertexProperty;
+  vertexProperty.push_back(nanoply::PlyProperty(nanoply::NNP_FLOAT32, nanoply::NNP_PXYZ));
+  vertexProperty.push_back(nanoply::PlyProperty(nanoply::NNP_FLOAT32, nanoply::NNP_NXYZ));
+  vertexProperty.push_back(nanoply::PlyProperty(nanoply::NNP_UINT8, nanoply::NNP_CRGBA));
+  vertexProperty.push_back(nanoply::PlyProperty(nanoply::NNP_FLOAT32, nanoply::NNP_TEXTURE2D));
+
+  std::vector<nanoply::PlyProperty> faceProperty;
+  faceProperty.push_back(nanoply::PlyProperty(nanoply::NNP_LIST_UINT8_UINT32, nanoply::NNP_FACE_VERTEX_LIST));
+
+  nanoply::PlyElement vertexElement(nanoply::NNP_VERTEX_ELEM, vertexProperty, mesh.vertices.size());
+  nanoply::PlyElement faceElement(nanoply::NNP_FACE_ELEM, faceProperty, mesh.triangles.size());
+
+  // Every descriptor points to the first member of the vertex it reads from, and
+  // strides over the vertices.
+  nanoply::ElementDescriptor vertex(nanoply::NNP_VERTEX_ELEM);
+  if (!mesh.vertices.empty())
+  {
+    AttributedVertex *vertices = const_cast<AttributedVertex *>(mesh.vertices.data());
+    vertex.dataDescriptor.push_back(
+        new nanoply::DataDescriptor<AttributedVertex, 3, float>(nanoply::NNP_PXYZ, &vertices->x));
+    vertex.dataDescriptor.push_back(
+        new nanoply::DataDescriptor<AttributedVertex, 3, float>(nanoply::NNP_NXYZ, &vertices->nx));
+    vertex.dataDescriptor.push_back(
+        new nanoply::DataDescriptor<AttributedVertex, 4, unsigned char>(nanoply::NNP_CRGBA, &vertices->red));
+    vertex.dataDescriptor.push_back(
+        new nanoply::DataDescriptor<AttributedVertex, 2, float>(nanoply::NNP_TEXTURE2D, &vertices->u));
+  }
+
+  nanoply::ElementDescriptor face(nanoply::NNP_FACE_ELEM);
+  if (!mesh.triangles.empty())
+  {
+    face.dataDescriptor.push_back(new nanoply::DataDescriptor<Triangle, 3, std::int32_t>(
+        nanoply::NNP_FACE_VERTEX_LIST, const_cast<Triangle *>(mesh.triangles.data())));
+  }
+
+  std::vector<nanoply::ElementDescriptor *> meshDescriptors = {&vertex, &face};
+
+  nanoply::Info info;
+  info.filename = filename;
+  info.binary = format != Format::Ascii;
+  info.AddPlyElement(vertexElement);
+  info.AddPlyElement(faceElement);
+  const bool success = nanoply::SaveModel(info.filename, meshDescriptors, info);
+
+  for (std::size_t i = 0; i < vertex.dataDescriptor.size(); i++) { delete vertex.dataDescriptor[i]; }
+  for (std::size_t i = 0; i < face.dataDescriptor.size(); i++) { delete face.dataDescriptor[i]; }
+
+  return success;
+}
+
+void writeAttributedPlywoot(const AttributedTriangleMesh &mesh, Format format, std::ostream &os)
+{
+  plywoot::OStream plyos{
+      format == Format::Ascii ? plywoot::PlyFormat::Ascii : plywoot::PlyFormat::BinaryLittleEndian};
+
+  std::vector<plywoot::PlyProperty> vertexProperties;
+  for (const char *name : {"x", "y", "z", "nx", "ny", "nz"})
+  {
+    vertexProperties.emplace_back(name, plywoot::PlyDataType::Float);
+  }
+  for (const char *name : {"red", "green", "blue", "alpha"})
+  {
+    vertexProperties.emplace_back(name, plywoot::PlyDataType::UChar);
+  }
+  for (const char *name : {"u", "v"}) { vertexProperties.emplace_back(name, plywoot::PlyDataType::Float); }
+  const plywoot::PlyElement vertexElement{"vertex", mesh.vertices.size(), std::move(vertexProperties)};
+
+  const plywoot::PlyProperty faceIndices{
+      "vertex_indices", plywoot::PlyDataType::Int, plywoot::PlyDataType::UChar};
+  const plywoot::PlyElement faceElement{"face", mesh.triangles.size(), {faceIndices}};
+
+  using TriangleLayout = plywoot::reflect::Layout<plywoot::reflect::Array<int, 3>>;
+  using VertexLayout = plywoot::reflect::Layout<
+      plywoot::reflect::Pack<float, 6>,
+      plywoot::reflect::Pack<std::uint8_t, 4>,
+      plywoot::reflect::Pack<float, 2>>;
+
+  plyos.add(vertexElement, VertexLayout{mesh.vertices});
+  plyos.add(faceElement, TriangleLayout{mesh.triangles});
+
+  plyos.write(os);
+}
+
+bool writeAttributedRPly(const AttributedTriangleMesh &mesh, p_ply ply)
+{
+  if (ply)
+  {
+    ply_add_element(ply, "vertex", mesh.vertices.size());
+    for (const char *name : {"x", "y", "z", "nx", "ny", "nz"})
+    {
+      ply_add_scalar_property(ply, name, PLY_FLOAT);
+    }
+    for (const char *name : {"red", "green", "blue", "alpha"})
+    {
+      ply_add_scalar_property(ply, name, PLY_UCHAR);
+    }
+    for (const char *name : {"u", "v"}) { ply_add_scalar_property(ply, name, PLY_FLOAT); }
+
+    ply_add_element(ply, "face", mesh.triangles.size());
+    ply_add_list_property(ply, "vertex_indices", PLY_UINT8, PLY_INT);
+
+    ply_write_header(ply);
+
+    for (const AttributedVertex &v : mesh.vertices)
+    {
+      for (float value : {v.x, v.y, v.z, v.nx, v.ny, v.nz}) { ply_write(ply, value); }
+      for (std::uint8_t value : {v.red, v.green, v.blue, v.alpha}) { ply_write(ply, value); }
+      ply_write(ply, v.u);
+      ply_write(ply, v.v);
+    }
+
+    for (const Triangle &t : mesh.triangles)
+    {
+      ply_write(ply, 3);
+      ply_write(ply, t.a);
+      ply_write(ply, t.b);
+      ply_write(ply, t.c);
+    }
+
+    return ply_close(ply);
+  }
+
+  return false;
+}
+
+void writeAttributedTinyply(const AttributedTriangleMesh &mesh, Format format, std::ostream &os)
+{
+  SplitAttributedVertices split{mesh.vertices};
+
+  tinyply::PlyFile outFile;
+  outFile.add_properties_to_element(
+      "vertex", {"x", "y", "z", "nx", "ny", "nz"}, tinyply::Type::FLOAT32, mesh.vertices.size(),
+      reinterpret_cast<uint8_t *>(split.floats.data()), tinyply::Type::INVALID, 0);
+  outFile.add_properties_to_element(
+      "vertex", {"red", "green", "blue", "alpha"}, tinyply::Type::UINT8, mesh.vertices.size(),
+      split.colors.data(), tinyply::Type::INVALID, 0);
+  outFile.add_properties_to_element(
+      "vertex", {"u", "v"}, tinyply::Type::FLOAT32, mesh.vertices.size(),
+      reinterpret_cast<uint8_t *>(split.textureCoordinates.data()), tinyply::Type::INVALID, 0);
+  outFile.add_properties_to_element(
+      "face", {"vertex_indices"}, tinyply::Type::UINT32, mesh.triangles.size(),
+      reinterpret_cast<uint8_t *>(const_cast<Triangle *>(mesh.triangles.data())), tinyply::Type::UINT8, 3);
+  outFile.write(os, format != Format::Ascii);
+}
+}
+
+TemporaryFile writeHapply(const TriangleMesh &mesh, Format format)
+{
+  TemporaryFile tf;
+  writeHapply(mesh, format, tf.stream());
+  return tf;
+}
+
+TemporaryFile writeMshPly(const TriangleMesh &mesh, Format format)
+{
+  TemporaryFile tf;
+  writeMshPly(mesh, format, tf.filename());
+  return tf;
+}
+
+TemporaryFile writeNanoPly(const TriangleMesh &mesh, Format format)
+{
+  TemporaryFile tf;
+  writeNanoPly(mesh, format, tf.filename());
   return tf;
 }
+
+TemporaryFile writePlywoot(const TriangleMesh &mesh, Format format)
+{
+  TemporaryFile tf;
+  writePlywoot(mesh, format, tf.stream());
+  return tf;
+}
+
+TemporaryFile writeRPly(const TriangleMesh &mesh, Format format)
+{
+  TemporaryFile tf;
+  const e_ply_storage_mode mode = format == Format::Ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN;
+  writeRPly(mesh, ply_create(tf.filename().c_str(), mode, NULL, 0, NULL));
+  return tf;
+}
+
+TemporaryFile writeTinyply(const TriangleMesh &mesh, Format format)
+{
+  TemporaryFile tf;
+  writeTinyply(mesh, format, tf.stream());
+  return tf;
+}
+
+bool writeHapply(const TriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writeHapply(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
+
+bool writeMshPly(const TriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  return !sink.filename().empty() && writeMshPly(mesh, format, sink.filename());
+}
+
+bool writeNanoPly(const TriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  return !sink.filename().empty() && writeNanoPly(mesh, format, sink.filename());
+}
+
+bool writePlywoot(const TriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writePlywoot(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
+
+bool writeRPly(const TriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  FILE *fp = sink.file();
+  if (!fp) { return false; }
+
+  const e_ply_storage_mode mode = format == Format::Ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN;
+  return writeRPly(mesh, ply_create_to_file(fp, mode, NULL, 0, NULL));
+}
+
+bool writeTinyply(const TriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writeTinyply(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
+
+bool writeSoaHapply(const SoaTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writeSoaHapply(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
+
+bool writeSoaMshPly(const SoaTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  return !sink.filename().empty() && writeSoaMshPly(mesh, format, sink.filename());
+}
+
+bool writeSoaRPly(const SoaTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  FILE *fp = sink.file();
+  if (!fp) { return false; }
+
+  const e_ply_storage_mode mode = format == Format::Ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN;
+  return writeSoaRPly(mesh, ply_create_to_file(fp, mode, NULL, 0, NULL));
+}
+
+bool writeSoaTinyply(const SoaTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writeSoaTinyply(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
+
+bool writeAttributedHapply(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writeAttributedHapply(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
+
+bool writeAttributedMshPly(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  return !sink.filename().empty() && writeAttributedMshPly(mesh, format, sink.filename());
+}
+
+bool writeAttributedNanoPly(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  return !sink.filename().empty() && writeAttributedNanoPly(mesh, format, sink.filename());
+}
+
+bool writeAttributedPlywoot(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writeAttributedPlywoot(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
+
+bool writeAttributedRPly(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  FILE *fp = sink.file();
+  if (!fp) { return false; }
+
+  const e_ply_storage_mode mode = format == Format::Ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN;
+  return writeAttributedRPly(mesh, ply_create_to_file(fp, mode, NULL, 0, NULL));
+}
+
+bool writeAttributedTinyply(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink)
+{
+  writeAttributedTinyply(mesh, format, sink.stream());
+  return bool(sink.stream());
+}
@@ -1,30 +1,41 @@
 #pragma once
 
 #include "mesh.h"
+#include "output_sink.h"
 #include "util.h"
 
 #include <string>
 
-enum class Format { Ascii, BinaryLittleEndian, BinaryBigEndian };
-
-inline std::string formatToString(Format format)
-{
-  switch (format)
-  {
-    case Format::Ascii:
-      return "ASCII";
-    case Format::BinaryBigEndian:
-      return "Binary big endian";
-    case Format::BinaryLittleEndian:
-      return "Binary little endian";
-  }
-
-  return {};
-}
-
 TemporaryFile writeHapply(const TriangleMesh &mesh, Format format);
 TemporaryFile writeMshPly(const TriangleMesh &mesh, Format format);
 TemporaryFile writeNanoPly(const TriangleMesh &mesh, Format format);
 TemporaryFile writePlywoot(const TriangleMesh &mesh, Format format);
 TemporaryFile writeRPly(const TriangleMesh &mesh, Format format);
 TemporaryFile writeTinyply(const TriangleMesh &mesh, Format format);
+
+// Writers to an output sink; return false in case of an error. Since msh_ply
+// and nanoply can only write to a file by name, these only support the `Tmpfs`
+// and `Disk` sinks.
+bool writeHapply(const TriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeMshPly(const TriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeNanoPly(const TriangleMesh &mesh, Format format, OutputSink &sink);
+bool writePlywoot(const TriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeRPly(const TriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeTinyply(const TriangleMesh &mesh, Format format, OutputSink &sink);
+
+// Writers of meshes that store their vertices as a structure of arrays, see
+// `SoaTriangleMesh`, to an output sink, for the libraries that are able to
+// write the array of every coordinate directly.
+bool writeSoaHapply(const SoaTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeSoaMshPly(const SoaTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeSoaRPly(const SoaTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeSoaTinyply(const SoaTriangleMesh &mesh, Format format, OutputSink &sink);
+
+// Writers of meshes with vertex normals, colors and texture coordinates, see
+// `AttributedVertex`, to an output sink.
+bool writeAttributedHapply(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeAttributedMshPly(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeAttributedNanoPly(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeAttributedPlywoot(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeAttributedRPly(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink);
+bool writeAttributedTinyply(const AttributedTriangleMesh &mesh, Format format, OutputSink &sink);